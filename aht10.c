@@ -2,11 +2,24 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "i2c_bus.h"
 #include "hardware/gpio.h"
 
 // Variáveis globais
 static bool aht10_initialized = false;
 
+// Sondagem usada na negociação de velocidade: teste de enlace puro. Lê o status duas vezes
+// e compara (sem exigir o bit de calibração, que alguns clones nunca ligam); um bit corrompido
+// pela velocidade reprova. O bit de ocupado é ignorado porque pode mudar entre as leituras.
+static bool aht10_probe(void) {
+    uint8_t status[2];
+    if (i2c_bus_write(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &(uint8_t){AHT10_CMD_STATUS}, 1, true) < 0) return false;
+    for (int i = 0; i < 2; i++) {
+        if (i2c_bus_read(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &status[i], 1, false) < 0) return false;
+    }
+    return ((status[0] ^ status[1]) & ~AHT10_STATUS_BUSY) == 0;
+}
+
 // Inicialização do I2C para AHT10
 bool aht10_init(void) {
     printf("Inicializando sensor AHT10...\n");
@@ -15,14 +28,8 @@ bool aht10_init(void) {
     printf("  - SCL: GPIO %d\n", AHT10_SCL_PIN);
     printf("  - Frequência: %d Hz\n", AHT10_I2C_FREQ);
     
-    // Inicializar I2C
-    i2c_init(AHT10_I2C_PORT, AHT10_I2C_FREQ);
-    
-    // Configurar pinos
-    gpio_set_function(AHT10_SDA_PIN, GPIO_FUNC_I2C);
-    gpio_set_function(AHT10_SCL_PIN, GPIO_FUNC_I2C);
-    gpio_pull_up(AHT10_SDA_PIN);
-    gpio_pull_up(AHT10_SCL_PIN);
+    // Inicializar I2C e configurar pinos
+    i2c_bus_init(I2C_BUS_SENSOR, AHT10_I2C_PORT, AHT10_SDA_PIN, AHT10_SCL_PIN, AHT10_I2C_FREQ);
     
     printf("I2C inicializado com sucesso!\n");
     
@@ -38,7 +45,7 @@ bool aht10_init(void) {
     // Reset do sensor
     printf("Executando reset do AHT10...\n");
     uint8_t reset_cmd = AHT10_CMD_SOFTRST;
-    int ret = i2c_write_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, &reset_cmd, 1, false);
+    int ret = i2c_bus_write(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &reset_cmd, 1, false);
     if (ret < 0) {
         printf("❌ Falha no reset do AHT10\n");
         return false;
@@ -48,7 +55,7 @@ bool aht10_init(void) {
     // Comando de inicialização/calibração
     printf("Inicializando/calibrando AHT10...\n");
     uint8_t init_cmd[3] = {AHT10_CMD_INIT, 0x08, 0x00};
-    ret = i2c_write_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, init_cmd, 3, false);
+    ret = i2c_bus_write(I2C_BUS_SENSOR, AHT10_I2C_ADDR, init_cmd, 3, false);
     if (ret < 0) {
         printf("❌ Falha na inicialização do AHT10\n");
         return false;
@@ -57,9 +64,9 @@ bool aht10_init(void) {
     
     // Verificar status de calibração
     uint8_t status;
-    ret = i2c_write_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, &(uint8_t){AHT10_CMD_STATUS}, 1, true);
+    ret = i2c_bus_write(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &(uint8_t){AHT10_CMD_STATUS}, 1, true);
     if (ret >= 0) {
-        ret = i2c_read_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, &status, 1, false);
+        ret = i2c_bus_read(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &status, 1, false);
         if (ret >= 0 && (status & AHT10_STATUS_CALIBRATED)) {
             printf("✅ AHT10 calibrado com sucesso!\n");
         } else {
@@ -67,6 +74,9 @@ bool aht10_init(void) {
         }
     }
     
+    // Negociar a maior velocidade estável (read-back do status a cada degrau)
+    i2c_bus_negotiate(I2C_BUS_SENSOR, AHT10_I2C_FREQ_MAX, aht10_probe);
+    
     aht10_initialized = true;
     printf("✅ AHT10 inicializado e pronto!\n");
     return true;
@@ -78,9 +88,9 @@ bool aht10_detect(void) {
     printf("Testando endereço 0x%02X...\n", AHT10_I2C_ADDR);
     
     uint8_t status;
-    int ret = i2c_write_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, &(uint8_t){AHT10_CMD_STATUS}, 1, true);
+    int ret = i2c_bus_write(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &(uint8_t){AHT10_CMD_STATUS}, 1, true);
     if (ret >= 0) {
-        ret = i2c_read_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, &status, 1, false);
+        ret = i2c_bus_read(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &status, 1, false);
         if (ret >= 0) {
             printf("✅ AHT10 encontrado no endereço 0x%02X\n", AHT10_I2C_ADDR);
             printf("Status inicial: 0x%02X\n", status);
@@ -102,10 +112,10 @@ bool aht10_is_ready(void) {
     if (!aht10_initialized) return false;
     
     uint8_t status;
-    int ret = i2c_write_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, &(uint8_t){AHT10_CMD_STATUS}, 1, true);
+    int ret = i2c_bus_write(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &(uint8_t){AHT10_CMD_STATUS}, 1, true);
     if (ret < 0) return false;
     
-    ret = i2c_read_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, &status, 1, false);
+    ret = i2c_bus_read(I2C_BUS_SENSOR, AHT10_I2C_ADDR, &status, 1, false);
     if (ret < 0) return false;
     
     // Sensor está pronto quando não está ocupado
@@ -117,7 +127,7 @@ bool aht10_trigger_measurement(void) {
     if (!aht10_initialized) return false;
     
     uint8_t trigger_cmd[3] = {AHT10_CMD_TRIGGER, AHT10_TRIGGER_DATA1, AHT10_TRIGGER_DATA2};
-    int ret = i2c_write_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, trigger_cmd, 3, false);
+    int ret = i2c_bus_write(I2C_BUS_SENSOR, AHT10_I2C_ADDR, trigger_cmd, 3, false);
     
     return ret >= 0;
 }
@@ -154,7 +164,7 @@ bool aht10_read_data(aht10_data_t* data) {
     
     // Ler 6 bytes de dados
     uint8_t raw_data[6];
-    int ret = i2c_read_blocking(AHT10_I2C_PORT, AHT10_I2C_ADDR, raw_data, 6, false);
+    int ret = i2c_bus_read(I2C_BUS_SENSOR, AHT10_I2C_ADDR, raw_data, 6, false);
     
     if (ret < 0) {
         printf("❌ Falha na leitura dos dados\n");
@@ -191,47 +201,3 @@ bool aht10_read_data(aht10_data_t* data) {
     data->valid = true;
     return true;
 }
-
-// Determinar nível de conforto baseado em temperatura e umidade
-const char* aht10_get_comfort_level(float temp, float humidity) {
-    // Zona de conforto: 20-26°C e 40-60% umidade
-    if (temp >= 20.0f && temp <= 26.0f && humidity >= 40.0f && humidity <= 60.0f) {
-        return "😊 CONFORTÁVEL";
-    }
-    // Muito frio
-    else if (temp < 15.0f) {
-        return "🥶 MUITO FRIO";
-    }
-    // Frio
-    else if (temp < 20.0f) {
-        return "❄️ FRIO";
-    }
-    // Muito quente
-    else if (temp > 30.0f) {
-        return "🔥 MUITO QUENTE";
-    }
-    // Quente
-    else if (temp > 26.0f) {
-        return "🌡️ QUENTE";
-    }
-    // Muito seco
-    else if (humidity < 30.0f) {
-        return "🏜️ MUITO SECO";
-    }
-    // Seco
-    else if (humidity < 40.0f) {
-        return "🌵 SECO";
-    }
-    // Muito úmido
-    else if (humidity > 70.0f) {
-        return "💧 MUITO ÚMIDO";
-    }
-    // Úmido
-    else if (humidity > 60.0f) {
-        return "🌊 ÚMIDO";
-    }
-    // Caso padrão
-    else {
-        return "🤔 MODERADO";
-    }
-}
@@ -8,7 +8,11 @@
 #define AHT10_I2C_PORT i2c0
 #define AHT10_SDA_PIN 0
 #define AHT10_SCL_PIN 1
-#define AHT10_I2C_FREQ 400000
+#define AHT10_I2C_FREQ 400000       // Velocidade inicial (detecção/calibração)
+#define AHT10_I2C_FREQ_MAX 1000000  // Limite da negociação (Fast-mode Plus)
+
+// Compensação de temperatura (ajuste baseado na diferença observada com estações meteorológicas)
+#define AHT10_TEMP_COMPENSATION (-2.3f)
 
 // Endereço I2C do AHT10
 #define AHT10_I2C_ADDR 0x38
@@ -40,6 +44,5 @@ bool aht10_detect(void);
 bool aht10_read_data(aht10_data_t* data);
 bool aht10_trigger_measurement(void);
 bool aht10_is_ready(void);
-const char* aht10_get_comfort_level(float temp, float humidity);
 
 #endif // AHT10_H
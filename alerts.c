@@ -0,0 +1,477 @@
+#include "alerts.h"
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+// ===== CONFIGURAÇÕES =====
+// Último setor da flash, bem longe do binário do programa
+#define ALERTS_FLASH_OFFSET  (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+
+// Imagem da tabela na flash: cabeçalho + regras + checksum
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t count;
+    uint8_t reserved;
+    alert_rule_t rules[ALERTS_MAX_RULES];
+    uint32_t checksum;  // FNV-1a de todos os campos anteriores
+} alerts_flash_image_t;
+
+#define ALERTS_FLASH_IMAGE_SIZE \
+    ((sizeof(alerts_flash_image_t) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE)
+
+// Estado por regra
+typedef struct {
+    bool active;
+    bool pending;           // Condição satisfeita, aguardando hold_ms
+    uint32_t pending_since; // Início da condição (ms)
+} alert_rule_state_t;
+
+// ===== TABELA PADRÃO =====
+// Unifica os limiares que antes estavam espalhados entre aht10.c e display.c.
+// Ordem importa apenas para desempate: com mesma severidade vence a primeira regra.
+static const alert_rule_t default_rules[] = {
+    // grandeza                  comparador       severidade               limiar  hist.  hold   símbolo rótulo
+    {ALERT_METRIC_TEMPERATURE, ALERT_CMP_BELOW, ALERT_SEVERITY_CRITICAL, 0, 15.0f, 0.5f, 2000, "!C", "MUITO FRIO"},
+    {ALERT_METRIC_TEMPERATURE, ALERT_CMP_ABOVE, ALERT_SEVERITY_CRITICAL, 0, 40.0f, 0.5f, 2000, "!Q", "MUITO QUENTE"},
+    {ALERT_METRIC_HUMIDITY,    ALERT_CMP_ABOVE, ALERT_SEVERITY_CRITICAL, 0, 70.0f, 2.0f, 2000, "!H", "MUITO UMIDO"},
+    {ALERT_METRIC_TEMPERATURE, ALERT_CMP_BELOW, ALERT_SEVERITY_WARNING,  0, 20.0f, 0.5f, 2000, "!C", "FRIO"},
+    {ALERT_METRIC_TEMPERATURE, ALERT_CMP_ABOVE, ALERT_SEVERITY_WARNING,  0, 26.0f, 0.5f, 2000, "",   "QUENTE"},
+    {ALERT_METRIC_HUMIDITY,    ALERT_CMP_BELOW, ALERT_SEVERITY_WARNING,  0, 30.0f, 2.0f, 2000, "",   "MUITO SECO"},
+    {ALERT_METRIC_HUMIDITY,    ALERT_CMP_BELOW, ALERT_SEVERITY_INFO,     0, 40.0f, 2.0f, 2000, "",   "SECO"},
+    {ALERT_METRIC_HUMIDITY,    ALERT_CMP_ABOVE, ALERT_SEVERITY_INFO,     0, 60.0f, 2.0f, 2000, "",   "UMIDO"},
+};
+
+// ===== VARIÁVEIS GLOBAIS =====
+static alert_rule_t rule_table[ALERTS_MAX_RULES];
+static uint8_t rule_count = 0;
+static alert_rule_state_t rule_states[ALERTS_MAX_RULES];
+static alert_state_t alert_state;
+
+// ===== FUNÇÕES AUXILIARES =====
+
+static uint32_t alerts_checksum(const uint8_t* data, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool alerts_rule_is_valid(const alert_rule_t* rule) {
+    if (rule->metric >= ALERT_METRIC_COUNT) return false;
+    if (rule->comparator > ALERT_CMP_ABOVE) return false;
+    if (rule->severity < ALERT_SEVERITY_INFO || rule->severity > ALERT_SEVERITY_CRITICAL) return false;
+    if (!(rule->hysteresis >= 0.0f)) return false;  // Também rejeita NaN
+    if (rule->threshold != rule->threshold) return false;
+    if (memchr(rule->symbol, '\0', ALERTS_SYMBOL_LEN) == NULL) return false;
+    if (memchr(rule->label, '\0', ALERTS_LABEL_LEN) == NULL) return false;
+    return true;
+}
+
+// ===== FUNÇÕES PRINCIPAIS =====
+
+void alerts_init(void) {
+    printf("[ALERTAS] Inicializando motor de regras...\n");
+
+    alerts_set_rules(default_rules, sizeof(default_rules) / sizeof(default_rules[0]));
+
+    if (alerts_load_from_flash()) {
+        printf("[ALERTAS] ✅ %d regras carregadas da flash (offset 0x%06X)\n",
+               rule_count, ALERTS_FLASH_OFFSET);
+    } else {
+        printf("[ALERTAS] Usando tabela padrão (%d regras)\n", rule_count);
+    }
+}
+
+void alerts_reset(void) {
+    // O contador de transições é acumulado desde o boot, mesmo após trocar a tabela
+    uint32_t transitions = alert_state.transitions;
+    memset(rule_states, 0, sizeof(rule_states));
+    memset(&alert_state, 0, sizeof(alert_state));
+    alert_state.transitions = transitions;
+    alert_state.status_label = ALERTS_STATUS_IDEAL;
+    for (int m = 0; m < ALERT_METRIC_COUNT; m++) {
+        alert_state.metric_symbol[m] = "";
+    }
+}
+
+static bool alerts_table_is_valid(const alert_rule_t* rules, uint8_t count) {
+    if (!rules || count == 0 || count > ALERTS_MAX_RULES) return false;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (!alerts_rule_is_valid(&rules[i])) {
+            printf("[ALERTAS] ❌ Regra %d inválida, tabela rejeitada\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Recalcular máscara, severidade, rótulo e símbolos a partir do estado de cada regra
+static void alerts_summarize(void) {
+    uint32_t active_mask = 0;
+    uint8_t max_severity = ALERT_SEVERITY_NONE;
+    uint8_t metric_severity[ALERT_METRIC_COUNT] = {ALERT_SEVERITY_NONE};
+    const char* status_label = ALERTS_STATUS_IDEAL;
+    const char* metric_symbol[ALERT_METRIC_COUNT];
+    for (int m = 0; m < ALERT_METRIC_COUNT; m++) {
+        metric_symbol[m] = "";
+    }
+
+    for (uint8_t i = 0; i < rule_count; i++) {
+        const alert_rule_t* rule = &rule_table[i];
+        if (!rule_states[i].active) continue;
+
+        active_mask |= (1u << i);
+        if (rule->severity > max_severity) {
+            max_severity = rule->severity;
+            status_label = rule->label;
+        }
+        if (rule->symbol[0] != '\0' && rule->severity > metric_severity[rule->metric]) {
+            metric_severity[rule->metric] = rule->severity;
+            metric_symbol[rule->metric] = rule->symbol;
+        }
+    }
+
+    alert_state.active_mask = active_mask;
+    alert_state.max_severity = max_severity;
+    alert_state.status_label = status_label;
+    for (int m = 0; m < ALERT_METRIC_COUNT; m++) {
+        alert_state.metric_symbol[m] = metric_symbol[m];
+    }
+}
+
+// Trocar a tabela mantendo o estado (ativa/aguardando hold) das regras que não mudaram,
+// mesmo que tenham mudado de posição. Regra ativa removida ou alterada gera NORMALIZADO aqui,
+// pois seu índice deixa de existir; a versão alterada volta a ativar só após o hold.
+bool alerts_set_rules(const alert_rule_t* rules, uint8_t count) {
+    if (!alerts_table_is_valid(rules, count)) return false;
+
+    alert_rule_state_t states[ALERTS_MAX_RULES];
+    bool kept[ALERTS_MAX_RULES] = {false};
+    memset(states, 0, sizeof(states));
+
+    for (uint8_t i = 0; i < count; i++) {
+        // Mesma posição primeiro, para regras duplicadas não trocarem de estado
+        int match = -1;
+        if (i < rule_count && !kept[i] && memcmp(&rule_table[i], &rules[i], sizeof(alert_rule_t)) == 0) {
+            match = i;
+        }
+        for (uint8_t j = 0; match < 0 && j < rule_count; j++) {
+            if (!kept[j] && memcmp(&rule_table[j], &rules[i], sizeof(alert_rule_t)) == 0) {
+                match = j;
+            }
+        }
+        if (match >= 0) {
+            kept[match] = true;
+            states[i] = rule_states[match];
+        }
+    }
+
+    for (uint8_t j = 0; j < rule_count; j++) {
+        if (!kept[j] && rule_states[j].active) {
+            printf("[ALERTAS] ✅ NORMALIZADO: %s (regra %d removida ou alterada)\n", rule_table[j].label, j);
+            alert_state.transitions++;
+        }
+    }
+
+    // rules pode apontar para a própria tabela ativa
+    memmove(rule_table, rules, count * sizeof(alert_rule_t));
+    memcpy(rule_states, states, sizeof(rule_states));
+    rule_count = count;
+
+    alerts_summarize();
+    alert_state.changed_mask = 0;
+    return true;
+}
+
+uint8_t alerts_get_rules(const alert_rule_t** rules) {
+    if (rules) *rules = rule_table;
+    return rule_count;
+}
+
+bool alerts_load_from_flash(void) {
+    const alerts_flash_image_t* image = (const alerts_flash_image_t*)(XIP_BASE + ALERTS_FLASH_OFFSET);
+
+    if (image->magic != ALERTS_FLASH_MAGIC || image->version != ALERTS_FLASH_VERSION) {
+        return false;
+    }
+
+    uint32_t checksum = alerts_checksum((const uint8_t*)image, offsetof(alerts_flash_image_t, checksum));
+    if (checksum != image->checksum) {
+        printf("[ALERTAS] ⚠️ Checksum da tabela na flash inválido\n");
+        return false;
+    }
+
+    return alerts_set_rules(image->rules, image->count);
+}
+
+bool alerts_save_to_flash(const alert_rule_t* rules, uint8_t count) {
+    // Validar antes de gravar: nunca persistir uma tabela que não carregaria.
+    // Só grava; aplicar é com alerts_set_rules (SALVAR grava a tabela que já está ativa).
+    if (!alerts_table_is_valid(rules, count)) return false;
+
+    static uint8_t page_buffer[ALERTS_FLASH_IMAGE_SIZE];
+    memset(page_buffer, 0xFF, sizeof(page_buffer));
+
+    alerts_flash_image_t* image = (alerts_flash_image_t*)page_buffer;
+    memset(image, 0, sizeof(*image));
+    image->magic = ALERTS_FLASH_MAGIC;
+    image->version = ALERTS_FLASH_VERSION;
+    image->count = count;
+    memcpy(image->rules, rules, count * sizeof(alert_rule_t));
+    image->checksum = alerts_checksum(page_buffer, offsetof(alerts_flash_image_t, checksum));
+
+    printf("[ALERTAS] Gravando %d regras na flash...\n", count);
+
+    // XIP fica indisponível durante erase/program: nada pode rodar da flash
+    uint32_t irq_state = save_and_disable_interrupts();
+    flash_range_erase(ALERTS_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(ALERTS_FLASH_OFFSET, page_buffer, sizeof(page_buffer));
+    restore_interrupts(irq_state);
+
+    return memcmp((const void*)(XIP_BASE + ALERTS_FLASH_OFFSET), page_buffer, sizeof(page_buffer)) == 0;
+}
+
+float alerts_get_metric(const aht10_data_t* data, alert_metric_t metric) {
+    switch (metric) {
+        case ALERT_METRIC_TEMPERATURE: return data->temperature + AHT10_TEMP_COMPENSATION;
+        case ALERT_METRIC_HUMIDITY:    return data->humidity;
+        default:                       return 0.0f;
+    }
+}
+
+// Avaliar todas as regras uma vez por amostra - custo constante por regra
+bool alerts_evaluate(const aht10_data_t* data, uint32_t now_ms) {
+    if (!data || !data->valid) return false;
+
+    uint64_t start_us = time_us_64();
+
+    float values[ALERT_METRIC_COUNT];
+    for (int m = 0; m < ALERT_METRIC_COUNT; m++) {
+        values[m] = alerts_get_metric(data, (alert_metric_t)m);
+    }
+
+    for (uint8_t i = 0; i < rule_count; i++) {
+        const alert_rule_t* rule = &rule_table[i];
+        alert_rule_state_t* state = &rule_states[i];
+        float value = values[rule->metric];
+
+        // Ativa ao cruzar o limiar; só desativa após sair da banda de histerese
+        bool trip, hold;
+        if (rule->comparator == ALERT_CMP_BELOW) {
+            trip = value < rule->threshold;
+            hold = value < rule->threshold + rule->hysteresis;
+        } else {
+            trip = value > rule->threshold;
+            hold = value > rule->threshold - rule->hysteresis;
+        }
+
+        if (!state->active) {
+            if (trip) {
+                if (!state->pending) {
+                    state->pending = true;
+                    state->pending_since = now_ms;
+                }
+                if (now_ms - state->pending_since >= rule->hold_ms) {
+                    state->active = true;
+                }
+            } else {
+                state->pending = false;
+            }
+        } else if (!hold) {
+            state->active = false;
+            state->pending = false;
+        }
+    }
+
+    uint32_t previous_mask = alert_state.active_mask;
+    alerts_summarize();
+
+    uint32_t changed_mask = alert_state.active_mask ^ previous_mask;
+    for (uint32_t bits = changed_mask; bits; bits &= bits - 1) {
+        alert_state.transitions++;
+    }
+
+    alert_state.changed_mask = changed_mask;
+    alert_state.last_eval_us = (uint32_t)(time_us_64() - start_us);
+
+    return changed_mask != 0;
+}
+
+const alert_state_t* alerts_get_state(void) {
+    return &alert_state;
+}
+
+// Medir custo de avaliação com uma varredura sintética (preserva o estado atual)
+void alerts_benchmark(uint32_t iterations) {
+    if (iterations == 0 || rule_count == 0) return;
+
+    static alert_rule_state_t saved_rules[ALERTS_MAX_RULES];
+    static alert_state_t saved_state;
+    memcpy(saved_rules, rule_states, sizeof(rule_states));
+    saved_state = alert_state;
+
+    aht10_data_t sample = {.valid = true};
+    uint64_t start_us = time_us_64();
+    for (uint32_t i = 0; i < iterations; i++) {
+        // Varre 0-50°C e 0-100% para exercitar ativação e histerese
+        sample.temperature = (float)(i % 500) * 0.1f;
+        sample.humidity = (float)(i % 1000) * 0.1f;
+        alerts_evaluate(&sample, i * 2000);
+    }
+    uint64_t elapsed_us = time_us_64() - start_us;
+
+    memcpy(rule_states, saved_rules, sizeof(rule_states));
+    alert_state = saved_state;
+
+    uint32_t ns_per_eval = (uint32_t)(elapsed_us * 1000 / iterations);
+    printf("[ALERTAS] Benchmark: %lu avaliações, %lu ns/avaliação, %lu ns/regra (%d regras)\n",
+           (unsigned long)iterations, (unsigned long)ns_per_eval,
+           (unsigned long)(ns_per_eval / rule_count), rule_count);
+}
+
+// ===== CONSOLE SERIAL =====
+
+static const char* const metric_codes = "TU";    // Índice = alert_metric_t
+static const char* const severity_codes = "-IWC"; // Índice = alert_severity_t
+
+// Menor representação decimal que relida com strtof dá o mesmo float (27.55 continua 27.55):
+// cada linha do LISTAR pode ser colada de volta sem alterar a regra
+static const char* alerts_format_float(char* buf, size_t len, float value) {
+    for (int digits = 6; digits < 9; digits++) {
+        snprintf(buf, len, "%.*g", digits, value);
+        if (strtof(buf, NULL) == value) return buf;
+    }
+    snprintf(buf, len, "%.9g", value);
+    return buf;
+}
+
+static void alerts_print_rules(void) {
+    char threshold[16], hysteresis[16];
+    for (uint8_t i = 0; i < rule_count; i++) {
+        const alert_rule_t* rule = &rule_table[i];
+        printf("[ALERTAS] %d: ALERTAS SET %d %c %c %s %s %lu %c %s %s\n",
+               i, i,
+               metric_codes[rule->metric],
+               rule->comparator == ALERT_CMP_BELOW ? '<' : '>',
+               alerts_format_float(threshold, sizeof(threshold), rule->threshold),
+               alerts_format_float(hysteresis, sizeof(hysteresis), rule->hysteresis),
+               (unsigned long)rule->hold_ms,
+               severity_codes[rule->severity],
+               rule->symbol[0] != '\0' ? rule->symbol : "-",
+               rule->label);
+    }
+}
+
+// Interpretar "SET <i> <T|U> <<|>> <limiar> <hist> <hold_ms> <I|W|C> <simbolo|-> <rotulo>"
+static bool alerts_parse_set(const char* args) {
+    unsigned index;
+    char metric, comparator, severity;
+    float threshold, hysteresis;
+    unsigned long hold_ms;
+    char symbol[8];
+    int label_pos = 0;
+
+    if (sscanf(args, "%u %c %c %f %f %lu %c %7s %n", &index, &metric, &comparator,
+               &threshold, &hysteresis, &hold_ms, &severity, symbol, &label_pos) != 8 || label_pos == 0) {
+        printf("[ALERTAS] ❌ Uso: ALERTAS SET <i> <T|U> <<|>> <limiar> <hist> <hold_ms> <I|W|C> <simbolo|-> <rotulo>\n");
+        return false;
+    }
+    if (index > rule_count || index >= ALERTS_MAX_RULES) {
+        printf("[ALERTAS] ❌ Índice %u fora da tabela (0-%d)\n", index, rule_count);
+        return false;
+    }
+
+    const char* metric_pos = strchr(metric_codes, toupper((unsigned char)metric));
+    const char* severity_pos = strchr(severity_codes, toupper((unsigned char)severity));
+    if (!metric_pos || !severity_pos || severity_pos == severity_codes || (comparator != '<' && comparator != '>')) {
+        printf("[ALERTAS] ❌ Grandeza, comparador ou severidade inválidos\n");
+        return false;
+    }
+
+    const char* label = args + label_pos;
+    size_t label_len = strlen(label);
+    while (label_len > 0 && isspace((unsigned char)label[label_len - 1])) label_len--;
+    if (label_len == 0 || label_len >= ALERTS_LABEL_LEN || (strcmp(symbol, "-") != 0 && strlen(symbol) >= ALERTS_SYMBOL_LEN)) {
+        printf("[ALERTAS] ❌ Rótulo (1-%d) ou símbolo (0-%d caracteres) inválido\n",
+               ALERTS_LABEL_LEN - 1, ALERTS_SYMBOL_LEN - 1);
+        return false;
+    }
+
+    alert_rule_t rule;
+    memset(&rule, 0, sizeof(rule));
+    rule.metric = (uint8_t)(metric_pos - metric_codes);
+    rule.comparator = (comparator == '<') ? ALERT_CMP_BELOW : ALERT_CMP_ABOVE;
+    rule.severity = (uint8_t)(severity_pos - severity_codes);
+    rule.threshold = threshold;
+    rule.hysteresis = hysteresis;
+    rule.hold_ms = (uint32_t)hold_ms;
+    if (strcmp(symbol, "-") != 0) {
+        for (size_t i = 0; symbol[i] != '\0'; i++) rule.symbol[i] = (char)toupper((unsigned char)symbol[i]);
+    }
+    // Fonte do display só tem maiúsculas
+    for (size_t i = 0; i < label_len; i++) rule.label[i] = (char)toupper((unsigned char)label[i]);
+
+    alert_rule_t rules[ALERTS_MAX_RULES];
+    memcpy(rules, rule_table, rule_count * sizeof(alert_rule_t));
+    rules[index] = rule;
+    uint8_t count = (index == rule_count) ? rule_count + 1 : rule_count;
+    return alerts_set_rules(rules, count);
+}
+
+// Comandos de console para alterar limiares em tempo de execução (sem regravar o firmware).
+// As alterações valem imediatamente na RAM; "ALERTAS SALVAR" as persiste na flash.
+// Retorna true se a linha era um comando de alertas.
+bool alerts_handle_command(const char* line) {
+    if (!line) return false;
+    while (isspace((unsigned char)*line)) line++;
+    if (strncmp(line, "ALERTAS", 7) != 0) return false;
+    line += 7;
+    while (isspace((unsigned char)*line)) line++;
+
+    bool ok = true;
+    if (*line == '\0' || strncmp(line, "LISTAR", 6) == 0) {
+        alerts_print_rules();
+        return true;
+    } else if (strncmp(line, "SET ", 4) == 0) {
+        ok = alerts_parse_set(line + 4);
+    } else if (strncmp(line, "DEL ", 4) == 0) {
+        unsigned index = (unsigned)strtoul(line + 4, NULL, 10);
+        if (index >= rule_count || rule_count <= 1) {
+            printf("[ALERTAS] ❌ Índice inválido (a tabela precisa de ao menos uma regra)\n");
+            ok = false;
+        } else {
+            alert_rule_t rules[ALERTS_MAX_RULES];
+            memcpy(rules, rule_table, rule_count * sizeof(alert_rule_t));
+            memmove(&rules[index], &rules[index + 1], (rule_count - index - 1) * sizeof(alert_rule_t));
+            ok = alerts_set_rules(rules, rule_count - 1);
+        }
+    } else if (strncmp(line, "PADRAO", 6) == 0) {
+        ok = alerts_set_rules(default_rules, sizeof(default_rules) / sizeof(default_rules[0]));
+    } else if (strncmp(line, "RECARREGAR", 10) == 0) {
+        ok = alerts_load_from_flash();
+        if (!ok) printf("[ALERTAS] ❌ Nenhuma tabela válida na flash\n");
+    } else if (strncmp(line, "SALVAR", 6) == 0) {
+        // Só grava: a tabela já está ativa e o estado dos alertas não muda
+        ok = alerts_save_to_flash(rule_table, rule_count);
+        printf("[ALERTAS] %s\n", ok ? "✅ Tabela gravada na flash" : "❌ Falha ao gravar na flash");
+        return true;
+    } else {
+        printf("[ALERTAS] Comandos: LISTAR | SET ... | DEL <i> | PADRAO | RECARREGAR | SALVAR\n");
+        return true;
+    }
+
+    if (ok) {
+        printf("[ALERTAS] ✅ Tabela ativa com %d regras (não salva)\n", rule_count);
+        alerts_print_rules();
+    }
+    return true;
+}
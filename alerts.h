@@ -0,0 +1,77 @@
+#ifndef ALERTS_H
+#define ALERTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "aht10.h"  // Incluir para usar aht10_data_t
+
+// Configuração do motor de alertas
+#define ALERTS_MAX_RULES      16
+#define ALERTS_SYMBOL_LEN     3     // "!C" + '\0'
+#define ALERTS_LABEL_LEN      13    // "MUITO QUENTE" + '\0'
+#define ALERTS_STATUS_IDEAL   "IDEAL"
+
+// Tabela de regras gravada no último setor da flash (fora da área do programa).
+// Pode ser atualizada em tempo de execução ou via picotool sem regravar o firmware.
+#define ALERTS_FLASH_MAGIC    0x414C5254u  // "ALRT"
+#define ALERTS_FLASH_VERSION  1
+
+// Grandeza avaliada pela regra
+typedef enum {
+    ALERT_METRIC_TEMPERATURE = 0,  // Temperatura compensada (°C)
+    ALERT_METRIC_HUMIDITY    = 1,  // Umidade relativa (%)
+    ALERT_METRIC_COUNT
+} alert_metric_t;
+
+// Comparador da regra
+typedef enum {
+    ALERT_CMP_BELOW = 0,  // Ativa quando valor < limiar
+    ALERT_CMP_ABOVE = 1,  // Ativa quando valor > limiar
+} alert_cmp_t;
+
+// Severidade (maior valor = mais grave)
+typedef enum {
+    ALERT_SEVERITY_NONE     = 0,
+    ALERT_SEVERITY_INFO     = 1,
+    ALERT_SEVERITY_WARNING  = 2,
+    ALERT_SEVERITY_CRITICAL = 3,
+} alert_severity_t;
+
+// Regra compacta (32 bytes, layout fixo para armazenamento na flash)
+typedef struct {
+    uint8_t metric;                   // alert_metric_t
+    uint8_t comparator;               // alert_cmp_t
+    uint8_t severity;                 // alert_severity_t
+    uint8_t reserved;
+    float threshold;                  // Limiar de ativação
+    float hysteresis;                 // Banda para desativar (sempre >= 0)
+    uint32_t hold_ms;                 // Tempo que a condição deve persistir antes de ativar
+    char symbol[ALERTS_SYMBOL_LEN];   // Símbolo no display ("" = sem símbolo)
+    char label[ALERTS_LABEL_LEN];     // Texto de status (maiúsculas, fonte do display)
+} alert_rule_t;
+
+// Estado avaliado, compartilhado por display, serial e exportadores
+typedef struct {
+    uint32_t active_mask;             // Bit N = regra N ativa
+    uint32_t changed_mask;            // Regras que mudaram na última avaliação
+    uint8_t max_severity;             // Maior severidade ativa
+    const char* status_label;         // Rótulo da regra ativa mais grave (ou IDEAL)
+    const char* metric_symbol[ALERT_METRIC_COUNT];  // Símbolo mais grave por grandeza ("" se nenhum)
+    uint32_t transitions;             // Total de transições desde o boot
+    uint32_t last_eval_us;            // Custo da última avaliação
+} alert_state_t;
+
+// Funções do motor de alertas
+void alerts_init(void);
+void alerts_reset(void);
+bool alerts_load_from_flash(void);
+bool alerts_save_to_flash(const alert_rule_t* rules, uint8_t count);
+bool alerts_set_rules(const alert_rule_t* rules, uint8_t count);
+uint8_t alerts_get_rules(const alert_rule_t** rules);
+bool alerts_evaluate(const aht10_data_t* data, uint32_t now_ms);
+const alert_state_t* alerts_get_state(void);
+float alerts_get_metric(const aht10_data_t* data, alert_metric_t metric);
+void alerts_benchmark(uint32_t iterations);
+bool alerts_handle_command(const char* line);
+
+#endif // ALERTS_H
@@ -4,12 +4,17 @@
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "i2c_bus.h"
+#include "alerts.h"
 
 // ===== CONFIGURAÇÕES =====
 #define I2C_PORT i2c1
 #define I2C_SDA 14
 #define I2C_SCL 15
-#define I2C_FREQ 400000
+#define I2C_FREQ 400000       // Velocidade inicial (detecção)
+#define I2C_FREQ_MAX 1000000  // Limite da negociação (Fast-mode Plus)
 #define SSD1306_ADDR 0x3C
 
 // Configurações específicas para SSD1306 128x64
@@ -43,27 +48,92 @@
 #define SSD1306_CHARGEPUMP           0x8D
 #define SSD1306_EXTERNALVCC          0x1
 #define SSD1306_SWITCHCAPVCC         0x2
+#define SSD1306_NOP                  0xE3
+
+// Gráfico de tendência (página TENDENCIA): moldura nas linhas 2-6
+#define TREND_FRAME_Y0   16
+#define TREND_FRAME_Y1   55
+#define TREND_SAMPLES    (SSD1306_WIDTH - 2)  // Uma coluna por amostra dentro da moldura
+
+#define DISPLAY_FRAME_SIZE (SSD1306_WIDTH * SSD1306_PAGES)
 
 // ===== VARIÁVEIS GLOBAIS =====
 static bool display_initialized = false;
-static uint8_t display_buffer[SSD1306_WIDTH * SSD1306_PAGES];
+static uint8_t display_buffer[DISPLAY_FRAME_SIZE];   // Espelho do conteúdo atual da GDDRAM
+static uint8_t display_compose[DISPLAY_FRAME_SIZE];  // Quadro em montagem (estático + dinâmico)
+static uint8_t page_static[DISPLAY_PAGE_COUNT][DISPLAY_FRAME_SIZE];  // Camada estática pré-renderizada
+static bool page_on_screen = false;                  // false = GDDRAM não contém a página atual
+static bool error_on_screen = false;                 // Tela de erro ativa: rotação/botão suspensos
+static char error_text[22];                          // Mensagem da tela de erro (21 chars por linha)
+static display_page_t current_page = DISPLAY_PAGE_READING;
+static display_stats_t display_stats;
+static uint64_t page_shown_at_us = 0;
+
+// Dados exibidos nas páginas dinâmicas
+static aht10_data_t last_data;
+static float temp_min, temp_max, humidity_min, humidity_max;
+static float trend_history[TREND_SAMPLES];
+static uint32_t trend_count = 0;  // Total de amostras recebidas (índice circular = trend_count % TREND_SAMPLES)
+
+// Estado de energia do painel (desligado até display_init)
+static display_power_t power_state = DISPLAY_POWER_OFF;
+static uint64_t power_since_us = 0;
+static uint64_t power_time_us[DISPLAY_POWER_STATE_COUNT];
+static uint64_t last_activity_us = 0;
+
+// Botão de troca de página (atualizado na IRQ)
+static volatile uint32_t button_presses = 0;
+static volatile alarm_id_t button_alarm = 0;       // Debounce pendente (0 = nenhum)
+static volatile bool button_stable_high = true;    // Último nível estável (pull-up = solto)
+
+static void display_render_static_pages(void);
+static void display_account_power(display_power_t state);
+static void display_button_irq(uint gpio, uint32_t events);
+static void display_draw_error_screen(void);
+
+static const char* const page_titles[DISPLAY_PAGE_COUNT] = {
+    [DISPLAY_PAGE_READING]     = "AHT10",
+    [DISPLAY_PAGE_MINMAX]      = "MIN MAX",
+    [DISPLAY_PAGE_TREND]       = "TENDENCIA",
+    [DISPLAY_PAGE_DIAGNOSTICS] = "DIAGNOSTICO",
+};
 
 // ===== FUNÇÕES AUXILIARES =====
 
 bool ssd1306_send_command(uint8_t cmd) {
     uint8_t buf[2] = {0x00, cmd};
-    int result = i2c_write_blocking(I2C_PORT, SSD1306_ADDR, buf, 2, false);
+    int result = i2c_bus_write(I2C_BUS_DISPLAY, SSD1306_ADDR, buf, 2, false);
     return result == 2;
 }
 
+// Vários comandos em uma única transação (byte de controle 0x00 seguido dos comandos)
+bool ssd1306_send_commands(const uint8_t *cmds, size_t len) {
+    uint8_t buf[len + 1];
+    buf[0] = 0x00;  // Command mode
+    memcpy(buf + 1, cmds, len);
+    int result = i2c_bus_write(I2C_BUS_DISPLAY, SSD1306_ADDR, buf, len + 1, false);
+    return result == (len + 1);
+}
+
 bool ssd1306_send_data(const uint8_t *data, size_t len) {
     uint8_t buf[len + 1];
     buf[0] = 0x40;  // Data mode
     memcpy(buf + 1, data, len);
-    int result = i2c_write_blocking(I2C_PORT, SSD1306_ADDR, buf, len + 1, false);
+    int result = i2c_bus_write(I2C_BUS_DISPLAY, SSD1306_ADDR, buf, len + 1, false);
     return result == (len + 1);
 }
 
+// Definir janela de escrita (colunas x0..x1, páginas p0..p1)
+static bool ssd1306_set_window(uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+    uint8_t cmds[6] = {SSD1306_COLUMNADDR, x0, x1, SSD1306_PAGEADDR, p0, p1};
+    return ssd1306_send_commands(cmds, sizeof(cmds));
+}
+
+// Sondagem usada na negociação de velocidade: comando NOP deve receber ACK
+static bool ssd1306_probe(void) {
+    return ssd1306_send_command(SSD1306_NOP);
+}
+
 // Fonte bitmap simples 5x8 para caracteres essenciais
 static const uint8_t font_5x8[][5] = {
     {0x3E, 0x51, 0x49, 0x45, 0x3E}, // '0' - 0
@@ -108,6 +178,8 @@ static const uint8_t font_5x8[][5] = {
     {0x14, 0x14, 0x14, 0x14, 0x14}, // '-' - 39
     {0x00, 0x60, 0x60, 0x00, 0x00}, // '.' - 40
     {0x08, 0x1C, 0x2A, 0x08, 0x08}, // '%' - 41
+    {0x08, 0x08, 0x3E, 0x08, 0x08}, // '+' - 42
+    {0x20, 0x10, 0x08, 0x04, 0x02}, // '/' - 43
 };
 
 // Função para obter índice da fonte
@@ -120,6 +192,8 @@ uint8_t get_font_index(char c) {
     if (c == '-') return 39;  // hífen
     if (c == '.') return 40;  // ponto
     if (c == '%') return 41;  // porcentagem
+    if (c == '+') return 42;  // mais
+    if (c == '/') return 43;  // barra
     return 36; // Espaço como padrão
 }
 
@@ -129,17 +203,13 @@ bool display_init(void) {
     printf("[DISPLAY] Inicializando I2C e SSD1306...\n");
     
     // Configurar I2C
-    i2c_init(I2C_PORT, I2C_FREQ);
-    gpio_set_function(I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(I2C_SDA);
-    gpio_pull_up(I2C_SCL);
+    i2c_bus_init(I2C_BUS_DISPLAY, I2C_PORT, I2C_SDA, I2C_SCL, I2C_FREQ);
     
     sleep_ms(100);
     
     // Verificar se o dispositivo responde
     uint8_t test_data = 0x00;
-    int result = i2c_write_blocking(I2C_PORT, SSD1306_ADDR, &test_data, 1, false);
+    int result = i2c_bus_write(I2C_BUS_DISPLAY, SSD1306_ADDR, &test_data, 1, false);
     if (result < 0) {
         printf("[DISPLAY] Erro: SSD1306 não detectado no endereço 0x%02X\n", SSD1306_ADDR);
         return false;
@@ -147,6 +217,9 @@ bool display_init(void) {
     
     printf("[DISPLAY] SSD1306 detectado! Configurando...\n");
     
+    // Negociar a maior velocidade estável (SSD1306 não permite leitura via I2C: teste de ACK)
+    i2c_bus_negotiate(I2C_BUS_DISPLAY, I2C_FREQ_MAX, ssd1306_probe);
+    
     // Sequência de inicialização para 128x64
     ssd1306_send_command(SSD1306_DISPLAYOFF);
     ssd1306_send_command(SSD1306_SETDISPLAYCLOCKDIV);
@@ -165,7 +238,7 @@ bool display_init(void) {
     ssd1306_send_command(SSD1306_SETCOMPINS);
     ssd1306_send_command(0x12);  // Alternative COM config
     ssd1306_send_command(SSD1306_SETCONTRAST);
-    ssd1306_send_command(0xCF);
+    ssd1306_send_command(DISPLAY_CONTRAST_NORMAL);
     ssd1306_send_command(SSD1306_SETPRECHARGE);
     ssd1306_send_command(0xF1);
     ssd1306_send_command(SSD1306_SETVCOMDETECT);
@@ -177,77 +250,471 @@ bool display_init(void) {
     display_initialized = true;
     printf("[DISPLAY] ✅ SSD1306 128x64 inicializado com sucesso!\n");
     
-    // Limpar o buffer
+    
+    // Pré-renderizar a camada estática de todas as páginas (uma única vez)
+    display_render_static_pages();
     memset(display_buffer, 0, sizeof(display_buffer));
+    page_on_screen = false;
+    
+    // Botão de troca de página: IRQ nas duas bordas, conta só quando o nível estabiliza em baixo
+    gpio_init(DISPLAY_BUTTON_PIN);
+    gpio_set_dir(DISPLAY_BUTTON_PIN, GPIO_IN);
+    gpio_pull_up(DISPLAY_BUTTON_PIN);
+    button_stable_high = gpio_get(DISPLAY_BUTTON_PIN);
+    gpio_set_irq_enabled_with_callback(DISPLAY_BUTTON_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true,
+                                       display_button_irq);
+    page_shown_at_us = time_us_64();
+    last_activity_us = page_shown_at_us;
+    display_account_power(DISPLAY_POWER_ON);
     
     return true;
 }
 
-void display_clear(uint16_t color) {
-    if (!display_initialized) return;
+// ===== RENDERIZAÇÃO EM RAM =====
+
+static void fb_set_pixel(uint8_t* fb, int x, int y, bool on) {
+    if (x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT) return;
+    uint8_t* cell = &fb[(y / 8) * SSD1306_WIDTH + x];
+    if (on) {
+        *cell |= (uint8_t)(1u << (y % 8));
+    } else {
+        *cell &= (uint8_t)~(1u << (y % 8));
+    }
+}
+
+static void fb_draw_hline(uint8_t* fb, int x0, int x1, int y) {
+    for (int x = x0; x <= x1; x++) fb_set_pixel(fb, x, y, true);
+}
+
+static void fb_draw_vline(uint8_t* fb, int x, int y0, int y1) {
+    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; }
+    for (int y = y0; y <= y1; y++) fb_set_pixel(fb, x, y, true);
+}
+
+// Texto alinhado a uma página de 8 pixels (mesmo layout da GDDRAM)
+static void fb_draw_text(uint8_t* fb, uint8_t x, uint8_t page, const char* text, bool invert) {
+    if (!text || page >= SSD1306_PAGES) return;
     
-    uint8_t pattern = (color == COLOR_BLACK) ? 0x00 : 0xFF;
+    uint8_t* row = &fb[page * SSD1306_WIDTH];
+    for (int i = 0; text[i] != '\0' && (x + i * 6) < SSD1306_WIDTH; i++) {
+        uint8_t font_idx = get_font_index(text[i]);
+        
+        // 5 pixels da fonte + 1 pixel de espaçamento
+        for (int j = 0; j < 6; j++) {
+            int col = x + i * 6 + j;
+            if (col >= SSD1306_WIDTH) break;
+            uint8_t bits = (j < 5) ? font_5x8[font_idx][j] : 0x00;
+            row[col] = invert ? (uint8_t)~bits : bits;
+        }
+    }
+}
+
+// Barra de título invertida com indicador de página (chrome estático)
+static void fb_draw_title(uint8_t* fb, const char* title, int page_index) {
+    memset(fb, 0xFF, SSD1306_WIDTH);
+    fb_draw_text(fb, 2, 0, title, true);
+    
+    if (page_index >= 0) {
+        char indicator[8];
+        snprintf(indicator, sizeof(indicator), "%d/%d", page_index + 1, DISPLAY_PAGE_COUNT);
+        fb_draw_text(fb, SSD1306_WIDTH - 2 - strlen(indicator) * 6, 0, indicator, true);
+    }
+}
+
+static void display_render_static_pages(void) {
+    memset(page_static, 0, sizeof(page_static));
     
-    // Configurar área completa
-    ssd1306_send_command(SSD1306_COLUMNADDR);
-    ssd1306_send_command(0);   // Start column
-    ssd1306_send_command(SSD1306_WIDTH - 1);   // End column
+    for (int p = 0; p < DISPLAY_PAGE_COUNT; p++) {
+        fb_draw_title(page_static[p], page_titles[p], p);
+    }
     
-    ssd1306_send_command(SSD1306_PAGEADDR);
-    ssd1306_send_command(0);   // Start page
-    ssd1306_send_command(SSD1306_PAGES - 1);   // End page
+    uint8_t* fb = page_static[DISPLAY_PAGE_READING];
+    fb_draw_text(fb, 0, 2, "TEMP", false);
+    fb_draw_text(fb, 0, 4, "UMID", false);
+    fb_draw_hline(fb, 0, SSD1306_WIDTH - 1, 46);
+    
+    fb = page_static[DISPLAY_PAGE_MINMAX];
+    fb_draw_text(fb, 0, 2, "T MIN", false);
+    fb_draw_text(fb, 0, 3, "T MAX", false);
+    fb_draw_text(fb, 0, 5, "U MIN", false);
+    fb_draw_text(fb, 0, 6, "U MAX", false);
+    
+    fb = page_static[DISPLAY_PAGE_TREND];
+    fb_draw_hline(fb, 0, SSD1306_WIDTH - 1, TREND_FRAME_Y0);
+    fb_draw_hline(fb, 0, SSD1306_WIDTH - 1, TREND_FRAME_Y1);
+    fb_draw_vline(fb, 0, TREND_FRAME_Y0, TREND_FRAME_Y1);
+    fb_draw_vline(fb, SSD1306_WIDTH - 1, TREND_FRAME_Y0, TREND_FRAME_Y1);
+    fb_draw_text(fb, 0, 7, "DT", false);
+    
+    fb = page_static[DISPLAY_PAGE_DIAGNOSTICS];
+    fb_draw_text(fb, 0, 2, "I2C0", false);
+    fb_draw_text(fb, 0, 3, "I2C1", false);
+    fb_draw_text(fb, 0, 4, "TROCA", false);
+    fb_draw_text(fb, 0, 5, "BYTES", false);
+    fb_draw_text(fb, 0, 6, "ALERTAS", false);
+    fb_draw_text(fb, 0, 7, "BATERIA", false);
+}
+
+static void format_temp(char* buf, size_t len, bool valid, float value) {
+    if (valid) {
+        snprintf(buf, len, "%.1fC", value);
+    } else {
+        snprintf(buf, len, "--");
+    }
+}
+
+static void format_humidity(char* buf, size_t len, bool valid, float value) {
+    if (valid) {
+        snprintf(buf, len, "%.1f%%", value);
+    } else {
+        snprintf(buf, len, "--");
+    }
+}
+
+static void display_render_trend(uint8_t* fb) {
+    uint32_t count = trend_count < TREND_SAMPLES ? trend_count : TREND_SAMPLES;
+    if (count == 0) {
+        fb_draw_text(fb, 18, 7, "--", false);
+        return;
+    }
     
-    // Limpar toda a tela
-    uint8_t data[128];  // Uma linha por vez
-    memset(data, pattern, sizeof(data));
+    // Amostra mais antiga primeiro
+    uint32_t oldest = trend_count - count;
+    float lo = trend_history[oldest % TREND_SAMPLES];
+    float hi = lo;
+    for (uint32_t i = oldest; i < trend_count; i++) {
+        float v = trend_history[i % TREND_SAMPLES];
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+    
+    // Escala automática com faixa mínima de 1°C para não amplificar ruído
+    if (hi - lo < 1.0f) {
+        float mid = (hi + lo) / 2.0f;
+        lo = mid - 0.5f;
+        hi = mid + 0.5f;
+    }
     
+    const int y_top = TREND_FRAME_Y0 + 2;
+    const int y_bottom = TREND_FRAME_Y1 - 2;
+    int prev_y = -1;
+    for (uint32_t i = 0; i < count; i++) {
+        float v = trend_history[(oldest + i) % TREND_SAMPLES];
+        int y = y_bottom - (int)((v - lo) / (hi - lo) * (float)(y_bottom - y_top) + 0.5f);
+        int x = 1 + (int)i;
+        if (prev_y >= 0) {
+            fb_draw_vline(fb, x, prev_y, y);
+        } else {
+            fb_set_pixel(fb, x, y, true);
+        }
+        prev_y = y;
+    }
+    
+    char buf[24];
+    float delta = trend_history[(trend_count - 1) % TREND_SAMPLES] - trend_history[oldest % TREND_SAMPLES];
+    snprintf(buf, sizeof(buf), "%+.1fC %.1f-%.1f", delta, lo, hi);
+    fb_draw_text(fb, 18, 7, buf, false);
+}
+
+// Compor a página atual: copia a camada estática e desenha só os campos dinâmicos
+static void display_compose_page(void) {
+    uint8_t* fb = display_compose;
+    memcpy(fb, page_static[current_page], DISPLAY_FRAME_SIZE);
+    
+    char buf[32];
+    bool valid = last_data.valid;
+    
+    switch (current_page) {
+        case DISPLAY_PAGE_READING: {
+            // Alertas e status vêm do estado já avaliado pelo motor de regras (sem limiares locais)
+            const alert_state_t* alerts = alerts_get_state();
+            float temp_compensada = alerts_get_metric(&last_data, ALERT_METRIC_TEMPERATURE);
+            
+            format_temp(buf, sizeof(buf), valid, temp_compensada);
+            if (valid && alerts->metric_symbol[ALERT_METRIC_TEMPERATURE][0] != '\0') {
+                strncat(buf, "  ", sizeof(buf) - strlen(buf) - 1);
+                strncat(buf, alerts->metric_symbol[ALERT_METRIC_TEMPERATURE], sizeof(buf) - strlen(buf) - 1);
+            }
+            fb_draw_text(fb, 36, 2, buf, false);
+            
+            format_humidity(buf, sizeof(buf), valid, last_data.humidity);
+            if (valid && alerts->metric_symbol[ALERT_METRIC_HUMIDITY][0] != '\0') {
+                strncat(buf, "  ", sizeof(buf) - strlen(buf) - 1);
+                strncat(buf, alerts->metric_symbol[ALERT_METRIC_HUMIDITY], sizeof(buf) - strlen(buf) - 1);
+            }
+            fb_draw_text(fb, 36, 4, buf, false);
+            
+            fb_draw_text(fb, 0, 7, valid ? alerts->status_label : "--", false);
+            break;
+        }
+        
+        case DISPLAY_PAGE_MINMAX:
+            format_temp(buf, sizeof(buf), trend_count > 0, temp_min);
+            fb_draw_text(fb, 48, 2, buf, false);
+            format_temp(buf, sizeof(buf), trend_count > 0, temp_max);
+            fb_draw_text(fb, 48, 3, buf, false);
+            format_humidity(buf, sizeof(buf), trend_count > 0, humidity_min);
+            fb_draw_text(fb, 48, 5, buf, false);
+            format_humidity(buf, sizeof(buf), trend_count > 0, humidity_max);
+            fb_draw_text(fb, 48, 6, buf, false);
+            break;
+        
+        case DISPLAY_PAGE_TREND:
+            display_render_trend(fb);
+            break;
+        
+        case DISPLAY_PAGE_DIAGNOSTICS:
+            for (int bus = 0; bus < I2C_BUS_COUNT; bus++) {
+                snprintf(buf, sizeof(buf), "%luK E%lu",
+                         (unsigned long)(i2c_bus_get_baudrate((i2c_bus_id_t)bus) / 1000),
+                         (unsigned long)i2c_bus_get_stats((i2c_bus_id_t)bus)->errors);
+                fb_draw_text(fb, 48, 2 + bus, buf, false);
+            }
+            snprintf(buf, sizeof(buf), "%luUS", (unsigned long)display_stats.last_switch_us);
+            fb_draw_text(fb, 48, 4, buf, false);
+            snprintf(buf, sizeof(buf), "%lu/%lu", (unsigned long)display_stats.last_switch_bytes,
+                     (unsigned long)display_stats.last_update_bytes);
+            fb_draw_text(fb, 48, 5, buf, false);
+            snprintf(buf, sizeof(buf), "%lu", (unsigned long)alerts_get_state()->transitions);
+            fb_draw_text(fb, 48, 6, buf, false);
+            
+            power_report_t report;
+            power_get_report(&report);
+            snprintf(buf, sizeof(buf), "%.0fH %.1fMA", report.battery_hours, report.avg_ma);
+            fb_draw_text(fb, 48, 7, buf, false);
+            break;
+        
+        default:
+            break;
+    }
+}
+
+// ===== ENVIO PARA O SSD1306 =====
+
+// Enviar o quadro inteiro (troca de página / telas especiais).
+// Retorna false se alguma transferência falhou: o espelho não é atualizado e a GDDRAM fica indefinida.
+static bool display_flush_full(void) {
+    if (!ssd1306_set_window(0, SSD1306_WIDTH - 1, 0, SSD1306_PAGES - 1)) return false;
     for (int page = 0; page < SSD1306_PAGES; page++) {
-        ssd1306_send_data(data, sizeof(data));
+        if (!ssd1306_send_data(&display_compose[page * SSD1306_WIDTH], SSD1306_WIDTH)) return false;
+    }
+    memcpy(display_buffer, display_compose, DISPLAY_FRAME_SIZE);
+    return true;
+}
+
+// Enviar apenas o trecho alterado de cada linha (a camada estática nunca difere).
+// Retorna false na primeira falha: sem a janela os dados cairiam na janela anterior e, com
+// NACK no meio dos dados, não se sabe quantos bytes chegaram - o chamador reenvia o quadro inteiro.
+static bool display_flush_dirty(void) {
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        const uint8_t* next = &display_compose[page * SSD1306_WIDTH];
+        uint8_t* shown = &display_buffer[page * SSD1306_WIDTH];
+        
+        int first = 0;
+        while (first < SSD1306_WIDTH && next[first] == shown[first]) first++;
+        if (first == SSD1306_WIDTH) continue;
+        
+        int last = SSD1306_WIDTH - 1;
+        while (last > first && next[last] == shown[last]) last--;
+        
+        if (!ssd1306_set_window(first, last, page, page) ||
+            !ssd1306_send_data(&next[first], last - first + 1)) {
+            return false;
+        }
+        memcpy(&shown[first], &next[first], last - first + 1);
+    }
+    return true;
+}
+
+static void display_refresh(void) {
+    // Sem leitura válida desde o erro: redesenhar o erro, nunca dados antigos
+    if (error_on_screen) {
+        display_draw_error_screen();
+        return;
+    }
+    
+    display_compose_page();
+    // Falha de escrita: espelho e painel divergem, a próxima atualização reenvia tudo
+    if (page_on_screen) {
+        page_on_screen = display_flush_dirty();
+    } else {
+        page_on_screen = display_flush_full();
+    }
+}
+
+// ===== ENERGIA DO PAINEL =====
+
+// Registrar o tempo no estado anterior e mudar de estado (sem enviar comandos)
+static void display_account_power(display_power_t state) {
+    uint64_t now_us = time_us_64();
+    power_time_us[power_state] += now_us - power_since_us;
+    power_since_us = now_us;
+    power_state = state;
+}
+
+static void display_set_power(display_power_t state) {
+    if (state == power_state) return;
+    
+    if (state == DISPLAY_POWER_OFF) {
+        ssd1306_send_command(SSD1306_DISPLAYOFF);
+    } else {
+        // Ajustar o contraste antes de religar para não piscar no brilho errado
+        uint8_t contrast = (state == DISPLAY_POWER_DIM) ? DISPLAY_CONTRAST_DIM : DISPLAY_CONTRAST_NORMAL;
+        uint8_t cmds[3] = {SSD1306_SETCONTRAST, contrast, SSD1306_DISPLAYON};
+        ssd1306_send_commands(cmds, power_state == DISPLAY_POWER_OFF ? 3 : 2);
+    }
+    
+    static const char* const names[DISPLAY_POWER_STATE_COUNT] = {"LIGADO", "ESMAECIDO", "DESLIGADO"};
+    printf("[DISPLAY] Energia: %s -> %s\n", names[power_state], names[state]);
+    display_account_power(state);
+}
+
+// Religar o painel (botão ou alerta) e reiniciar o tempo de inatividade
+void display_wake(void) {
+    if (!display_initialized) return;
+    
+    last_activity_us = time_us_64();
+    if (power_state == DISPLAY_POWER_ON) return;
+    
+    bool was_off = (power_state == DISPLAY_POWER_OFF);
+    display_set_power(DISPLAY_POWER_ON);
+    // A rotação fica parada com o painel esmaecido/desligado: a página atual ganha um ciclo inteiro
+    page_shown_at_us = last_activity_us;
+    if (was_off) {
+        // Atualizações foram suspensas enquanto desligado: enviar só o que mudou
+        display_refresh();
     }
 }
 
-void display_print_text_bitmap(uint8_t x, uint8_t y, const char* text, bool invert) {
-    if (!display_initialized || !text) return;
+display_power_t display_get_power(void) {
+    return power_state;
+}
+
+// Tempo total no estado (inclui o período em curso)
+uint64_t display_get_power_time_us(display_power_t state) {
+    if (state >= DISPLAY_POWER_STATE_COUNT) return 0;
     
-    // Verificar limites
-    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT) return;
+    uint64_t total = power_time_us[state];
+    if (state == power_state) {
+        total += time_us_64() - power_since_us;
+    }
+    return total;
+}
+
+// ===== GERENCIADOR DE PÁGINAS =====
+
+// Fim do debounce: amostrar o nível. Um toque é a passagem de solto (alto) para pressionado
+// (baixo), ambos estáveis por DISPLAY_BUTTON_DEBOUNCE_MS; o bounce da soltura não conta.
+static int64_t display_button_settled(alarm_id_t id, void* user_data) {
+    bool high = gpio_get(DISPLAY_BUTTON_PIN);
+    if (!high && button_stable_high) {
+        button_presses++;
+    }
+    button_stable_high = high;
+    button_alarm = 0;
+    return 0;
+}
+
+// Cada borda (inclusive bounce) reinicia a contagem do tempo de estabilidade
+static void display_button_irq(uint gpio, uint32_t events) {
+    if (gpio != DISPLAY_BUTTON_PIN || !(events & (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE))) return;
     
-    uint8_t page = y / 8;
-    if (page >= SSD1306_PAGES) return;
+    if (button_alarm > 0) {
+        cancel_alarm(button_alarm);
+    }
+    alarm_id_t id = add_alarm_in_ms(DISPLAY_BUTTON_DEBOUNCE_MS, display_button_settled, NULL, true);
+    button_alarm = (id > 0) ? id : 0;
+}
+
+void display_set_page(display_page_t page) {
+    if (!display_initialized || page >= DISPLAY_PAGE_COUNT) return;
     
-    printf("[DISPLAY] Bitmap (%d,%d): '%s' %s\n", x, y, text, invert ? "(invertido)" : "");
+    uint64_t start_us = time_us_64();
+    uint32_t start_bytes = i2c_bus_get_stats(I2C_BUS_DISPLAY)->bytes;
     
-    // Configurar posição
-    ssd1306_send_command(SSD1306_COLUMNADDR);
-    ssd1306_send_command(x);
-    ssd1306_send_command(SSD1306_WIDTH - 1);
+    current_page = page;
+    page_on_screen = false;
+    display_refresh();
     
-    ssd1306_send_command(SSD1306_PAGEADDR);
-    ssd1306_send_command(page);
-    ssd1306_send_command(page);
+    display_stats.switches++;
+    display_stats.last_switch_us = (uint32_t)(time_us_64() - start_us);
+    display_stats.last_switch_bytes = i2c_bus_get_stats(I2C_BUS_DISPLAY)->bytes - start_bytes;
+    page_shown_at_us = time_us_64();
     
-    // Renderizar cada caractere
-    for (int i = 0; i < strlen(text) && (x + i * 6) < SSD1306_WIDTH; i++) {
-        char c = text[i];
-        uint8_t font_idx = get_font_index(c);
-        
-        // Enviar os 5 pixels da fonte + 1 pixel de espaçamento
-        uint8_t char_data[6];
-        for (int j = 0; j < 5; j++) {
-            char_data[j] = invert ? ~font_5x8[font_idx][j] : font_5x8[font_idx][j];
+    printf("[DISPLAY] Página %d (%s): %lu bytes em %lu us\n",
+           page + 1, page_titles[page],
+           (unsigned long)display_stats.last_switch_bytes,
+           (unsigned long)display_stats.last_switch_us);
+}
+
+void display_next_page(void) {
+    display_set_page((display_page_t)((current_page + 1) % DISPLAY_PAGE_COUNT));
+}
+
+display_page_t display_get_page(void) {
+    return current_page;
+}
+
+// Processar botão e rotação automática (chamar fora de IRQ, no loop principal)
+void display_service(void) {
+    if (!display_initialized) return;
+    
+    // Ler e zerar com IRQs desligadas: um toque entre a leitura e a escrita não se perde
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t presses = button_presses;
+    button_presses = 0;
+    restore_interrupts(irq_state);
+    
+    if (presses > 0) {
+        // Com o painel apagado ou esmaecido, o primeiro toque só acorda
+        if (power_state != DISPLAY_POWER_ON) {
+            display_wake();
+            presses--;
         }
-        char_data[5] = invert ? 0xFF : 0x00;  // Espaçamento
-        
-        ssd1306_send_data(char_data, 6);
+        last_activity_us = time_us_64();
+        // Vários toques acumulados avançam várias páginas com um único redesenho
+        if (presses % DISPLAY_PAGE_COUNT != 0 && !error_on_screen) {
+            display_set_page((display_page_t)((current_page + presses) % DISPLAY_PAGE_COUNT));
+        }
+        return;
+    }
+    
+    if (power_state == DISPLAY_POWER_OFF) return;
+    
+    // Inatividade: esmaecer e depois desligar (DISPLAYOFF)
+    uint64_t idle_us = time_us_64() - last_activity_us;
+    if (DISPLAY_IDLE_OFF_MS > 0 && idle_us >= (uint64_t)DISPLAY_IDLE_OFF_MS * 1000) {
+        display_set_power(DISPLAY_POWER_OFF);
+        return;
+    }
+    if (DISPLAY_IDLE_DIM_MS > 0 && idle_us >= (uint64_t)DISPLAY_IDLE_DIM_MS * 1000 &&
+        power_state == DISPLAY_POWER_ON) {
+        display_set_power(DISPLAY_POWER_DIM);
+    }
+    
+    // Rotação automática só com o painel em brilho normal (esmaecido = sem tráfego)
+    // e suspensa enquanto a tela de erro estiver ativa
+    if (DISPLAY_PAGE_CYCLE_MS > 0 && power_state == DISPLAY_POWER_ON && !error_on_screen &&
+        time_us_64() - page_shown_at_us >= (uint64_t)DISPLAY_PAGE_CYCLE_MS * 1000) {
+        display_next_page();
     }
 }
 
-// Função para compatibilidade (mantida simples)
-void display_print_text(uint16_t x, uint16_t y, const char* text, uint16_t color, uint16_t bg_color) {
-    display_print_text_bitmap((uint8_t)x, (uint8_t)y, text, color == COLOR_BLACK);
+const display_stats_t* display_get_stats(void) {
+    return &display_stats;
 }
 
-// Atualizar dados do sensor no display - AJUSTADO PARA 128x64 COM ALERTAS
+// ===== API PÚBLICA =====
+
+void display_clear(uint16_t color) {
+    if (!display_initialized) return;
+    
+    memset(display_compose, (color == COLOR_BLACK) ? 0x00 : 0xFF, DISPLAY_FRAME_SIZE);
+    display_flush_full();
+    page_on_screen = false;
+}
+
+// Atualizar dados do sensor no display - só os campos dinâmicos alterados são enviados
 void display_update_sensor_data(aht10_data_t data) {
     if (!display_initialized) {
         printf("[DISPLAY OFFLINE] Temp: %.1f°C | Umidade: %.1f%%\n", 
@@ -259,87 +726,71 @@ void display_update_sensor_data(aht10_data_t data) {
         display_show_error_screen("Erro de leitura do sensor");
         return;
     }
-    
-    // Compensação de temperatura (ajuste baseado na diferença observada)
-    float temp_compensada = data.temperature - 2.3f;  // Corrige diferença com estações meteorológicas
-    
-    char temp_str[32];
-    char humidity_str[32];
-    char status_str[32];
-    
-    // Preparar strings para 128x64 COM ALERTAS (usando temperatura compensada)
-    // Temperatura com alertas condicionais
-    if (temp_compensada < 20.0f) {
-        snprintf(temp_str, sizeof(temp_str), "%.1fC  %s", temp_compensada, ALERT_LOW_TEMP);
-    } else if (temp_compensada > 40.0f) {
-        snprintf(temp_str, sizeof(temp_str), "%.1fC  %s", temp_compensada, ALERT_HIGH_TEMP);
-    } else {
-        snprintf(temp_str, sizeof(temp_str), "%.1fC", temp_compensada);
-    }
-    
-    // Umidade com alerta condicional
-    if (data.humidity > 70.0f) {
-        snprintf(humidity_str, sizeof(humidity_str), "%.1f%%  %s", data.humidity, ALERT_HIGH_HUMIDITY);
-    } else {
-        snprintf(humidity_str, sizeof(humidity_str), "%.1f%%", data.humidity);
+    if (error_on_screen) {
+        // Página volta a ser exibida por um ciclo completo antes da próxima rotação
+        error_on_screen = false;
+        page_shown_at_us = time_us_64();
     }
     
-    // Determinar status baseado na temperatura compensada e umidade
-    if (temp_compensada < 18.0f) {
-        strcpy(status_str, "FRIO");
-    } else if (temp_compensada > 28.0f) {
-        strcpy(status_str, "QUENTE");
-    } else if (data.humidity < 40.0f) {
-        strcpy(status_str, "SECO");
-    } else if (data.humidity > 70.0f) {
-        strcpy(status_str, "UMIDO");
+    // Histórico para as páginas MIN MAX e TENDENCIA (temperatura compensada)
+    float temp_compensada = alerts_get_metric(&data, ALERT_METRIC_TEMPERATURE);
+    if (trend_count == 0) {
+        temp_min = temp_max = temp_compensada;
+        humidity_min = humidity_max = data.humidity;
     } else {
-        strcpy(status_str, "IDEAL");
+        if (temp_compensada < temp_min) temp_min = temp_compensada;
+        if (temp_compensada > temp_max) temp_max = temp_compensada;
+        if (data.humidity < humidity_min) humidity_min = data.humidity;
+        if (data.humidity > humidity_max) humidity_max = data.humidity;
     }
+    trend_history[trend_count % TREND_SAMPLES] = temp_compensada;
+    trend_count++;
+    last_data = data;
     
-    // Limpar tela
-    display_clear(COLOR_BLACK);
+    // Painel desligado: manter histórico mas não gastar tráfego I2C
+    if (power_state == DISPLAY_POWER_OFF) return;
     
-    // Layout otimizado para 128x64 usando fonte bitmap
-    display_print_text_bitmap(0, 0, "AHT10", false);      // Título na linha 0
-    display_print_text_bitmap(0, 16, temp_str, false);    // Temperatura na linha 16 (com alerta se necessário)
-    display_print_text_bitmap(0, 32, humidity_str, false); // Umidade na linha 32 (com alerta se necessário)
-    display_print_text_bitmap(0, 48, status_str, false);   // Status na linha 48
+    uint32_t start_bytes = i2c_bus_get_stats(I2C_BUS_DISPLAY)->bytes;
+    display_refresh();
+    display_stats.last_update_bytes = i2c_bus_get_stats(I2C_BUS_DISPLAY)->bytes - start_bytes;
 }
 
 // Tela de inicialização - AJUSTADA PARA 128x64
 void display_show_startup_screen(void) {
     if (!display_initialized) return;
     
-    display_clear(COLOR_BLACK);
-    
-    // Layout compacto para 128x64
-    display_print_text_bitmap(0, 0, "SENSOR AHT10", false);
-    display_print_text_bitmap(0, 16, "INICIANDO...", false);
-    display_print_text_bitmap(0, 48, "AGUARDE", false);
+    memset(display_compose, 0, DISPLAY_FRAME_SIZE);
+    fb_draw_text(display_compose, 0, 0, "SENSOR AHT10", false);
+    fb_draw_text(display_compose, 0, 2, "INICIANDO...", false);
+    fb_draw_text(display_compose, 0, 6, "AGUARDE", false);
+    display_flush_full();
+    page_on_screen = false;
 }
 
 // Tela de erro - AJUSTADA PARA 128x64
+// A mensagem fica guardada até a próxima leitura válida: a rotação e o botão ficam suspensos
+// e religar o painel mostra o erro em vez dos últimos dados.
 void display_show_error_screen(const char* error_msg) {
     if (!display_initialized) return;
     
-    display_clear(COLOR_BLACK);
+    // 21 chars cabem em 128 pixels (21*6=126); mensagens maiores são truncadas
+    strncpy(error_text, error_msg, sizeof(error_text) - 1);
+    error_text[sizeof(error_text) - 1] = '\0';
+    error_on_screen = true;
     
-    // Layout de erro para 128x64
-    display_print_text_bitmap(0, 0, "ERRO!", true);  // Invertido para destacar
-    
-    // Quebrar mensagem de erro se necessário
-    if (strlen(error_msg) <= 21) {  // 21 chars cabem em 128 pixels (21*6=126)
-        display_print_text_bitmap(0, 24, error_msg, false);
-    } else {
-        // Mostrar só uma parte da mensagem
-        char short_msg[22];
-        strncpy(short_msg, error_msg, 21);
-        short_msg[21] = '\0';
-        display_print_text_bitmap(0, 24, short_msg, false);
-    }
-    
-    display_print_text_bitmap(0, 48, "VERIFIQUE CONEXAO", false);
+    if (power_state == DISPLAY_POWER_OFF) return;
+    display_draw_error_screen();
+}
+
+static void display_draw_error_screen(void) {
+    memset(display_compose, 0, DISPLAY_FRAME_SIZE);
+    fb_draw_text(display_compose, 0, 0, "ERRO!", true);  // Invertido para destacar
+    fb_draw_text(display_compose, 0, 3, error_text, false);
+    fb_draw_text(display_compose, 0, 6, "VERIFIQUE CONEXAO", false);
+    display_flush_full();
+    
+    // Próxima leitura válida precisa reenviar a página inteira
+    page_on_screen = false;
 }
 
 bool display_is_ready(void) {
@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "aht10.h"  // Incluir para usar aht10_data_t
+#include "power.h"  // Incluir para usar LOW_POWER_MODE
 
 // Configuração do display SSD1306 128x64
 #define DISPLAY_WIDTH  128
@@ -15,10 +16,48 @@
 #define COLOR_BLACK   0x00
 #define COLOR_WHITE   0x01
 
-// Símbolos de alerta
-#define ALERT_HIGH_HUMIDITY   "!H"  // Umidade > 70%
-#define ALERT_LOW_TEMP        "!C"  // Temperatura < 20°C  
-#define ALERT_HIGH_TEMP       "!Q"  // Temperatura > 40°C
+// Botão de troca de página (botão A da BitDogLab, ativo em nível baixo)
+#define DISPLAY_BUTTON_PIN         5
+#define DISPLAY_BUTTON_DEBOUNCE_MS 20    // Tempo que o nível precisa ficar estável após a última borda
+
+// Rotação automática das páginas (0 = somente pelo botão)
+#define DISPLAY_PAGE_CYCLE_MS      10000
+
+// Brilho e desligamento por inatividade (acorda com o botão ou com um alerta)
+#define DISPLAY_CONTRAST_NORMAL    0xCF
+#define DISPLAY_CONTRAST_DIM       0x01
+#if LOW_POWER_MODE
+#define DISPLAY_IDLE_DIM_MS        30000
+#define DISPLAY_IDLE_OFF_MS        60000
+#else
+#define DISPLAY_IDLE_DIM_MS        0      // 0 = desativado
+#define DISPLAY_IDLE_OFF_MS        0
+#endif
+
+// Estado de energia do painel
+typedef enum {
+    DISPLAY_POWER_ON = 0,   // Contraste normal
+    DISPLAY_POWER_DIM,      // Contraste reduzido
+    DISPLAY_POWER_OFF,      // DISPLAYOFF (GDDRAM preservada)
+    DISPLAY_POWER_STATE_COUNT
+} display_power_t;
+
+// Páginas do display
+typedef enum {
+    DISPLAY_PAGE_READING = 0,   // Leitura atual + status de alerta
+    DISPLAY_PAGE_MINMAX,        // Mínimos e máximos desde o boot
+    DISPLAY_PAGE_TREND,         // Gráfico das últimas amostras de temperatura
+    DISPLAY_PAGE_DIAGNOSTICS,   // Barramentos I2C, custo de troca de página, alertas
+    DISPLAY_PAGE_COUNT
+} display_page_t;
+
+// Custo de atualização medido no envio ao SSD1306
+typedef struct {
+    uint32_t switches;           // Trocas de página
+    uint32_t last_switch_us;     // Latência da última troca (composição + envio)
+    uint32_t last_switch_bytes;  // Bytes I2C enviados na última troca
+    uint32_t last_update_bytes;  // Bytes I2C enviados na última atualização de dados
+} display_stats_t;
 
 // Funções do display
 bool display_init(void);
@@ -26,5 +65,13 @@ void display_clear(uint16_t color);
 void display_update_sensor_data(aht10_data_t data);
 void display_show_startup_screen(void);
 void display_show_error_screen(const char* error_msg);
+void display_set_page(display_page_t page);
+void display_next_page(void);
+display_page_t display_get_page(void);
+void display_service(void);
+const display_stats_t* display_get_stats(void);
+void display_wake(void);
+display_power_t display_get_power(void);
+uint64_t display_get_power_time_us(display_power_t state);
 
 #endif // DISPLAY_H
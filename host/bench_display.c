@@ -0,0 +1,114 @@
+// Benchmark de troca de página no SSD1306 simulado: latência (tempo de barramento) e bytes
+// por troca e por atualização dos campos dinâmicos, em cada velocidade do I2C.
+// O custo de CPU da composição não é modelado (o relógio virtual só avança no barramento).
+//
+// Uso: bench_display [--check]   (--check falha se os limites abaixo forem excedidos)
+
+#include "sim.h"
+#include <string.h>
+#include "hardware/i2c.h"
+#include "aht10.h"
+#include "alerts.h"
+#include "display.h"
+#include "i2c_bus.h"
+
+// ===== CONFIGURAÇÕES =====
+#define BENCH_DISPLAY_PORT     1
+#define BENCH_ROUNDS           8      // Voltas completas pelas páginas em cada velocidade
+#define BENCH_MAX_SWITCH_BYTES 1100   // Quadro inteiro (1024) + janela e bytes de controle
+#define BENCH_MAX_UPDATE_BYTES 200    // Só os campos dinâmicos alterados
+#define BENCH_MAX_SWITCH_US_FM_PLUS 15000
+
+static const uint32_t bench_speeds[] = {I2C_BUS_SPEED_FAST_PLUS, I2C_BUS_SPEED_FAST, I2C_BUS_SPEED_STANDARD};
+static const char* const bench_page_names[DISPLAY_PAGE_COUNT] = {"LEITURA", "MIN/MAX", "TENDENCIA", "DIAGNOSTICO"};
+
+typedef struct {
+    uint64_t switch_us_total;
+    uint32_t switch_us_max;
+    uint64_t switch_bytes_total;
+    uint32_t switch_bytes_max;
+    uint64_t update_us_total;
+    uint64_t update_bytes_total;
+    uint32_t update_bytes_max;
+    uint32_t samples;
+} bench_result_t;
+
+static aht10_data_t bench_sample(uint32_t i) {
+    // Variação pequena a cada amostra, como entre leituras consecutivas reais
+    return (aht10_data_t){
+        .temperature = 24.0f + 0.1f * (float)(i % 17),
+        .humidity = 50.0f + 0.3f * (float)(i % 11),
+        .valid = true,
+    };
+}
+
+static void bench_speed(uint32_t speed, bench_result_t results[DISPLAY_PAGE_COUNT], uint32_t* sample) {
+    // Reprogramar o barramento do display na velocidade medida (sem negociação)
+    i2c_bus_init(I2C_BUS_DISPLAY, i2c1, DISPLAY_SDA_PIN, DISPLAY_SCL_PIN, speed);
+
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int page = 0; page < DISPLAY_PAGE_COUNT; page++) {
+            bench_result_t* r = &results[page];
+            display_set_page((display_page_t)page);
+            const display_stats_t* stats = display_get_stats();
+            r->switch_us_total += stats->last_switch_us;
+            r->switch_bytes_total += stats->last_switch_bytes;
+            if (stats->last_switch_us > r->switch_us_max) r->switch_us_max = stats->last_switch_us;
+            if (stats->last_switch_bytes > r->switch_bytes_max) r->switch_bytes_max = stats->last_switch_bytes;
+
+            uint64_t start_us = sim_now_us();
+            display_update_sensor_data(bench_sample((*sample)++));
+            r->update_us_total += sim_now_us() - start_us;
+            r->update_bytes_total += stats->last_update_bytes;
+            if (stats->last_update_bytes > r->update_bytes_max) r->update_bytes_max = stats->last_update_bytes;
+            r->samples++;
+
+            sim_advance_us(2000000);  // Intervalo entre amostras
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    bool check = argc > 1 && strcmp(argv[1], "--check") == 0;
+    bool ok = true;
+
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_i2c_reset();
+    sim_flash_reset();
+    sim_ssd1306_attach(BENCH_DISPLAY_PORT);
+    if (!display_init()) {
+        fprintf(stderr, "bench_display: display não inicializou\n");
+        return 1;
+    }
+    alerts_init();
+
+    uint32_t sample = 0;
+    for (int i = 0; i < 8; i++) display_update_sensor_data(bench_sample(sample++));  // Histórico inicial
+
+    // "Página" tem um caractere de 2 bytes: largura 13 alinha com as linhas de 12
+    printf("%-9s %-13s %20s %16s %8s %16s\n", "I2C", "Página", "troca us", "troca bytes", "atual us", "atual bytes");
+    for (size_t s = 0; s < sizeof(bench_speeds) / sizeof(bench_speeds[0]); s++) {
+        bench_result_t results[DISPLAY_PAGE_COUNT] = {0};
+        bench_speed(bench_speeds[s], results, &sample);
+
+        for (int page = 0; page < DISPLAY_PAGE_COUNT; page++) {
+            const bench_result_t* r = &results[page];
+            printf("%4lu kHz  %-12s %8llu (max %5lu) %5llu (max %4lu) %8llu %5llu (max %4lu)\n",
+                   (unsigned long)(bench_speeds[s] / 1000), bench_page_names[page],
+                   (unsigned long long)(r->switch_us_total / r->samples), (unsigned long)r->switch_us_max,
+                   (unsigned long long)(r->switch_bytes_total / r->samples), (unsigned long)r->switch_bytes_max,
+                   (unsigned long long)(r->update_us_total / r->samples),
+                   (unsigned long long)(r->update_bytes_total / r->samples), (unsigned long)r->update_bytes_max);
+
+            if (r->switch_bytes_max > BENCH_MAX_SWITCH_BYTES || r->update_bytes_max > BENCH_MAX_UPDATE_BYTES ||
+                (bench_speeds[s] == I2C_BUS_SPEED_FAST_PLUS && r->switch_us_max > BENCH_MAX_SWITCH_US_FM_PLUS)) {
+                printf("  ^ acima do limite (troca <= %u B, atualização <= %u B, troca a 1 MHz <= %u us)\n",
+                       BENCH_MAX_SWITCH_BYTES, BENCH_MAX_UPDATE_BYTES, BENCH_MAX_SWITCH_US_FM_PLUS);
+                ok = false;
+            }
+        }
+    }
+
+    return (check && !ok) ? 1 : 0;
+}
@@ -0,0 +1,7 @@
+// Subconjunto do hardware/clocks.h para o build de simulação no host
+#ifndef SIM_HARDWARE_CLOCKS_H
+#define SIM_HARDWARE_CLOCKS_H
+
+#include "hardware/structs/clocks.h"
+
+#endif // SIM_HARDWARE_CLOCKS_H
@@ -0,0 +1,42 @@
+// Registradores WAKE_EN/SLEEP_EN simulados (apenas armazenam o valor escrito)
+#ifndef SIM_HARDWARE_STRUCTS_CLOCKS_H
+#define SIM_HARDWARE_STRUCTS_CLOCKS_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t wake_en0;
+    volatile uint32_t wake_en1;
+    volatile uint32_t sleep_en0;
+    volatile uint32_t sleep_en1;
+} clocks_hw_t;
+
+extern clocks_hw_t sim_clocks_hw;
+#define clocks_hw (&sim_clocks_hw)
+
+#define CLOCKS_WAKE_EN0_CLK_ADC_ADC_BITS      (1u << 1)
+#define CLOCKS_WAKE_EN0_CLK_SYS_ADC_BITS      (1u << 2)
+#define CLOCKS_WAKE_EN0_CLK_SYS_JTAG_BITS     (1u << 9)
+#define CLOCKS_WAKE_EN0_CLK_SYS_PIO0_BITS     (1u << 12)
+#define CLOCKS_WAKE_EN0_CLK_SYS_PIO1_BITS     (1u << 13)
+#define CLOCKS_WAKE_EN0_CLK_SYS_PWM_BITS      (1u << 17)
+#define CLOCKS_WAKE_EN0_CLK_RTC_RTC_BITS      (1u << 21)
+#define CLOCKS_WAKE_EN0_CLK_SYS_RTC_BITS      (1u << 22)
+#define CLOCKS_WAKE_EN0_CLK_PERI_SPI0_BITS    (1u << 24)
+#define CLOCKS_WAKE_EN0_CLK_SYS_SPI0_BITS     (1u << 25)
+#define CLOCKS_WAKE_EN0_CLK_PERI_SPI1_BITS    (1u << 26)
+#define CLOCKS_WAKE_EN0_CLK_SYS_SPI1_BITS     (1u << 27)
+#define CLOCKS_WAKE_EN1_CLK_PERI_UART0_BITS   (1u << 6)
+#define CLOCKS_WAKE_EN1_CLK_SYS_UART0_BITS    (1u << 7)
+#define CLOCKS_WAKE_EN1_CLK_PERI_UART1_BITS   (1u << 8)
+#define CLOCKS_WAKE_EN1_CLK_SYS_UART1_BITS    (1u << 9)
+#define CLOCKS_WAKE_EN1_CLK_USB_USBCTRL_BITS  (1u << 10)
+#define CLOCKS_WAKE_EN1_CLK_SYS_USBCTRL_BITS  (1u << 11)
+
+#define CLOCKS_SLEEP_EN0_CLK_SYS_IO_BITS       (1u << 8)
+#define CLOCKS_SLEEP_EN0_CLK_SYS_PADS_BITS     (1u << 11)
+#define CLOCKS_SLEEP_EN1_CLK_SYS_TIMER_BITS    (1u << 5)
+#define CLOCKS_SLEEP_EN1_CLK_SYS_WATCHDOG_BITS (1u << 12)
+#define CLOCKS_SLEEP_EN1_CLK_SYS_XOSC_BITS     (1u << 14)
+
+#endif // SIM_HARDWARE_STRUCTS_CLOCKS_H
@@ -0,0 +1,16 @@
+// Registrador SCR simulado (apenas armazena o valor escrito)
+#ifndef SIM_HARDWARE_STRUCTS_SCB_H
+#define SIM_HARDWARE_STRUCTS_SCB_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t scr;
+} armv6m_scb_hw_t;
+
+extern armv6m_scb_hw_t sim_scb_hw;
+#define scb_hw (&sim_scb_hw)
+
+#define M0PLUS_SCR_SLEEPDEEP_BITS (1u << 2)
+
+#endif // SIM_HARDWARE_STRUCTS_SCB_H
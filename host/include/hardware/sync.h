@@ -0,0 +1,11 @@
+// Subconjunto do hardware/sync.h para o build de simulação no host.
+// As "IRQs" simuladas só disparam quando o relógio virtual avança, então não há o que mascarar.
+#ifndef SIM_HARDWARE_SYNC_H
+#define SIM_HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+static inline uint32_t save_and_disable_interrupts(void) { return 0; }
+static inline void restore_interrupts(uint32_t status) { (void)status; }
+
+#endif // SIM_HARDWARE_SYNC_H
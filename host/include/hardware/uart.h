@@ -0,0 +1,20 @@
+// Subconjunto do hardware/uart.h para o build de simulação no host.
+// A saída do stdio já é capturada por sim_printf, então não há FIFO a esvaziar.
+#ifndef SIM_HARDWARE_UART_H
+#define SIM_HARDWARE_UART_H
+
+typedef struct uart_inst {
+    int index;
+} uart_inst_t;
+
+extern uart_inst_t sim_uart_inst[2];
+
+#define uart0 (&sim_uart_inst[0])
+#define uart1 (&sim_uart_inst[1])
+#ifdef PICO_DEFAULT_UART
+#define uart_default (&sim_uart_inst[PICO_DEFAULT_UART])
+#endif
+
+static inline void uart_tx_wait_blocking(uart_inst_t* uart) { (void)uart; }
+
+#endif // SIM_HARDWARE_UART_H
@@ -0,0 +1,322 @@
+// Replay no host: executa o firmware sobre o relógio virtual com o AHT10 seguindo um
+// traço CSV (ou um ciclo diário sintético) e resume prazos, tráfego I2C, alertas e quadros.
+//
+// Uso: replay [--trace arquivo.csv] [--days N | --hours N] [--seed N] [--button S]
+//             [--console T:COMANDO] [--serial arq] [--frames arq] [--bus-log arq]
+//             [--uncalibrated] [--no-pullups] [--rise-ns N] [--error-rate P]
+//             [--max-missed N] [--max-util PCT[,PCT]] [--min-battery-hours H] [--quiet]
+
+#include "sim.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "aht10.h"
+#include "alerts.h"
+#include "display.h"
+#include "i2c_bus.h"
+#include "main.h"
+#include "power.h"
+
+// ===== CONFIGURAÇÕES =====
+#define REPLAY_MAX_TRANSITIONS_SHOWN 20
+#define REPLAY_BUTTON_HOLD_MS        120
+#define REPLAY_DISPLAY_PORT          1
+
+int app_main(void);
+
+typedef struct {
+    const char* trace;
+    double duration_s;
+    uint64_t seed;
+    double button_period_s;
+    const char* serial_path;
+    const char* frames_path;
+    const char* bus_log_path;
+    bool uncalibrated;
+    bool no_pullups;     // Sem resistores externos nas linhas I2C
+    long max_missed;     // < 0 = sem verificação
+    double max_util[I2C_BUS_COUNT];  // Por barramento; < 0 = sem verificação
+    double min_battery_hours;  // < 0 = sem verificação
+    bool quiet;
+} replay_options_t;
+
+// ===== VARIÁVEIS GLOBAIS =====
+static replay_options_t opts = {
+    .duration_s = 86400.0,
+    .seed = 1,
+    .max_missed = -1,
+    .min_battery_hours = -1.0,
+};
+// Linhas I2C com erros injetados (--rise-ns / --error-rate), mesmas condições nos dois barramentos
+static sim_i2c_line_t line = {.timeout_share = 0.1f};
+static bool inject_faults = false;
+static uint32_t transitions_seen = 0;
+static uint64_t button_period_us = 0;
+
+// ===== FUNÇÕES AUXILIARES =====
+
+static void format_time(char* buf, size_t len, uint64_t t_us) {
+    uint64_t s = t_us / SIM_US_PER_S;
+    snprintf(buf, len, "d%llu %02llu:%02llu:%02llu", (unsigned long long)(s / 86400),
+             (unsigned long long)(s / 3600 % 24), (unsigned long long)(s / 60 % 60), (unsigned long long)(s % 60));
+}
+
+// Transições impressas pelo firmware ("[ALERTAS] 🚨 ATIVO: ..." / "[ALERTAS] ✅ NORMALIZADO: ...")
+static void on_serial_line(uint64_t t_us, const char* line) {
+    if (strncmp(line, "[ALERTAS] ", 10) != 0) return;
+    if (!strstr(line, "ATIVO:") && !strstr(line, "NORMALIZADO:")) return;
+
+    if (!opts.quiet && transitions_seen < REPLAY_MAX_TRANSITIONS_SHOWN) {
+        char when[32];
+        format_time(when, sizeof(when), t_us);
+        printf("  [%s] %s\n", when, line + 10);
+    }
+    transitions_seen++;
+}
+
+static void press_button(void* arg) {
+    (void)arg;
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), REPLAY_BUTTON_HOLD_MS, 2);
+    sim_schedule(sim_now_us() + button_period_us, press_button, NULL);
+}
+
+static void run_firmware(void) {
+    app_main();
+}
+
+static FILE* open_output(const char* path) {
+    if (!path) return NULL;
+    if (strcmp(path, "-") == 0) return stdout;
+    FILE* f = fopen(path, "w");
+    if (!f) fprintf(stderr, "replay: não foi possível abrir %s\n", path);
+    return f;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "uso: replay [--trace arq.csv] [--days N | --hours N] [--seed N] [--button S]\n"
+            "            [--console T:COMANDO] [--serial arq|-] [--frames arq|-] [--bus-log arq|-]\n"
+            "            [--uncalibrated] [--no-pullups] [--rise-ns N] [--error-rate P]\n"
+            "            [--max-missed N] [--max-util PCT[,PCT]] [--min-battery-hours H] [--quiet]\n");
+    exit(2);
+}
+
+static void parse_args(int argc, char** argv) {
+    for (int bus = 0; bus < I2C_BUS_COUNT; bus++) {
+        opts.max_util[bus] = -1.0;
+    }
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool takes_value = true;
+
+        if (strcmp(arg, "--trace") == 0 && val) {
+            opts.trace = val;
+        } else if (strcmp(arg, "--days") == 0 && val) {
+            opts.duration_s = atof(val) * 86400.0;
+        } else if (strcmp(arg, "--hours") == 0 && val) {
+            opts.duration_s = atof(val) * 3600.0;
+        } else if (strcmp(arg, "--seed") == 0 && val) {
+            opts.seed = strtoull(val, NULL, 0);
+        } else if (strcmp(arg, "--button") == 0 && val) {
+            opts.button_period_s = atof(val);
+        } else if (strcmp(arg, "--console") == 0 && val) {
+            // T:COMANDO -> linha entregue ao console no segundo T
+            char* end;
+            double t = strtod(val, &end);
+            if (*end != ':') usage();
+            char text[128];
+            snprintf(text, sizeof(text), "%s\n", end + 1);
+            sim_serial_inject((uint64_t)(t * SIM_US_PER_S), text);
+        } else if (strcmp(arg, "--serial") == 0 && val) {
+            opts.serial_path = val;
+        } else if (strcmp(arg, "--frames") == 0 && val) {
+            opts.frames_path = val;
+        } else if (strcmp(arg, "--bus-log") == 0 && val) {
+            opts.bus_log_path = val;
+        } else if (strcmp(arg, "--rise-ns") == 0 && val) {
+            line.rise_ns = (float)atof(val);
+            inject_faults = true;
+        } else if (strcmp(arg, "--error-rate") == 0 && val) {
+            line.base_error_rate = (float)atof(val);
+            inject_faults = true;
+        } else if (strcmp(arg, "--max-missed") == 0 && val) {
+            opts.max_missed = atol(val);
+        } else if (strcmp(arg, "--max-util") == 0 && val) {
+            // Um valor vale para todos os barramentos; uma lista separada por vírgula, um por barramento
+            const char* item = val;
+            char* end = NULL;
+            double limit = 0.0;
+            for (int bus = 0; bus < I2C_BUS_COUNT; bus++) {
+                if (bus == 0 || *end == ',') {
+                    limit = strtod(item, &end);
+                    if (end == item) usage();
+                    item = end + 1;
+                }
+                opts.max_util[bus] = limit;
+            }
+            if (*end != '\0') usage();
+        } else if (strcmp(arg, "--min-battery-hours") == 0 && val) {
+            opts.min_battery_hours = atof(val);
+        } else {
+            takes_value = false;
+            if (strcmp(arg, "--uncalibrated") == 0) {
+                opts.uncalibrated = true;
+            } else if (strcmp(arg, "--no-pullups") == 0) {
+                opts.no_pullups = true;
+            } else if (strcmp(arg, "--quiet") == 0) {
+                opts.quiet = true;
+            } else {
+                usage();
+            }
+        }
+        if (takes_value) i++;
+    }
+}
+
+// ===== RELATÓRIO =====
+
+// Retorna false se algum limite de --max-* foi violado
+static bool print_report(double wall_s) {
+    const loop_stats_t* loop = main_get_loop_stats();
+    uint64_t now_us = sim_now_us();
+    uint64_t window_us = now_us > loop->start_us ? now_us - loop->start_us : 0;
+    bool ok = true;
+
+    printf("\n===== REPLAY =====\n");
+    printf("Simulado: %.2f dias em %.2f s (%.0fx tempo real)\n",
+           (double)now_us / SIM_US_PER_DAY, wall_s, wall_s > 0 ? (double)now_us / SIM_US_PER_S / wall_s : 0.0);
+    printf("Ambiente: %s | leituras do AHT10: %lu\n",
+           opts.trace ? opts.trace : "ciclo diário sintético", (unsigned long)sim_aht10_measurements());
+    if (inject_faults) {
+        printf("Linhas I2C: subida %.0f ns, ruído %.4f | erro por transferência: %.4f @ 1 MHz, %.4f @ 400 kHz, %.4f @ 100 kHz\n",
+               line.rise_ns, line.base_error_rate, sim_i2c_line_error_rate(&line, 1000000),
+               sim_i2c_line_error_rate(&line, 400000), sim_i2c_line_error_rate(&line, 100000));
+    }
+
+    printf("\n-- Prazos --\n");
+    printf("Ciclos: %lu | Prazos perdidos: %lu | Pior ciclo: %lu us\n",
+           (unsigned long)loop->cycles, (unsigned long)loop->missed_deadlines,
+           (unsigned long)loop->worst_cycle_us);
+    if (opts.max_missed >= 0 && loop->missed_deadlines > (uint32_t)opts.max_missed) {
+        printf("FALHA: prazos perdidos acima de %ld\n", opts.max_missed);
+        ok = false;
+    }
+
+    printf("\n-- Barramentos I2C (desde o início do loop) --\n");
+    for (int bus = 0; bus < I2C_BUS_COUNT; bus++) {
+        const i2c_bus_stats_t* stats = i2c_bus_get_stats((i2c_bus_id_t)bus);
+        uint64_t busy = stats->busy_us - loop->bus_busy_start_us[bus];
+        double util = window_us ? 100.0 * (double)busy / (double)window_us : 0.0;
+        printf("%s @ %lu Hz: %lu transações | %lu bytes | %lu erros (%lu timeouts) | "
+               "%lu fallbacks | %lu upgrades | utilização %.3f%%\n",
+               i2c_bus_get_name((i2c_bus_id_t)bus), (unsigned long)i2c_bus_get_baudrate((i2c_bus_id_t)bus),
+               (unsigned long)stats->transactions, (unsigned long)stats->bytes,
+               (unsigned long)stats->errors, (unsigned long)stats->timeouts,
+               (unsigned long)stats->fallbacks, (unsigned long)stats->upgrades, util);
+        if (opts.max_util[bus] >= 0 && util > opts.max_util[bus]) {
+            printf("FALHA: utilização de %s acima de %.3f%%\n", i2c_bus_get_name((i2c_bus_id_t)bus), opts.max_util[bus]);
+            ok = false;
+        }
+    }
+
+    printf("\n-- Alertas --\n");
+    printf("Transições: %lu (firmware: %lu) | status final: %s\n", (unsigned long)transitions_seen,
+           (unsigned long)alerts_get_state()->transitions, alerts_get_state()->status_label);
+
+    const sim_ssd1306_stats_t* panel = sim_ssd1306_get_stats();
+    const display_stats_t* display = display_get_stats();
+    printf("\n-- Display --\n");
+    printf("Quadros: %lu | bytes GDDRAM: %llu | trocas de página: %lu | painel %s\n",
+           (unsigned long)panel->frames, (unsigned long long)panel->data_bytes,
+           (unsigned long)display->switches, panel->display_on ? "ligado" : "desligado");
+
+    // Mesmo modelo de energia do firmware (power.c), sobre os tempos do relógio virtual
+    static const char* const panel_states[DISPLAY_POWER_STATE_COUNT] = {"ligado", "esmaecido", "desligado"};
+    power_report_t energy;
+    power_get_report(&energy);
+    printf("\n-- Energia (%s) --\n",
+           !LOW_POWER_MODE ? "modo normal" : LOW_POWER_UART_STDIO ? "modo de baixo consumo, UART" : "modo de baixo consumo");
+    printf("CPU ativa %.1f s / dormindo %.1f s (%.2f%% ativa)\n",
+           (double)energy.cpu_active_us / SIM_US_PER_S, (double)energy.cpu_sleep_us / SIM_US_PER_S,
+           energy.uptime_us ? 100.0 * (double)energy.cpu_active_us / (double)energy.uptime_us : 0.0);
+    printf("Painel:");
+    for (int state = 0; state < DISPLAY_POWER_STATE_COUNT; state++) {
+        printf(" %s %.1f%%", panel_states[state],
+               energy.uptime_us ? 100.0 * (double)display_get_power_time_us((display_power_t)state) / (double)energy.uptime_us : 0.0);
+    }
+    printf("\n");
+    printf("Corrente média %.2f mA | consumo %.2f mAh | autonomia estimada %.1f h (%.1f dias, %.0f mAh)\n",
+           energy.avg_ma, energy.consumed_mah, energy.battery_hours, energy.battery_hours / 24.0, POWER_BATTERY_MAH);
+    if (opts.min_battery_hours >= 0 && energy.battery_hours < opts.min_battery_hours) {
+        printf("FALHA: autonomia abaixo de %.1f h\n", opts.min_battery_hours);
+        ok = false;
+    }
+
+    printf("\n-- Serial --\n");
+    printf("Linhas: %lu\n", (unsigned long)sim_serial_lines());
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    parse_args(argc, argv);
+
+    sim_clock_reset();
+    sim_rand_seed(opts.seed);
+    sim_flash_reset();
+    sim_gpio_reset();
+    sim_i2c_reset();
+    sim_aht10_attach(0, !opts.uncalibrated);
+    if (opts.no_pullups) {
+        const unsigned i2c_pins[] = {AHT10_SDA_PIN, AHT10_SCL_PIN, DISPLAY_SDA_PIN, DISPLAY_SCL_PIN};
+        for (size_t i = 0; i < sizeof(i2c_pins) / sizeof(i2c_pins[0]); i++) {
+            sim_gpio_set_external_pullup(i2c_pins[i], false);
+        }
+    }
+    sim_ssd1306_attach(REPLAY_DISPLAY_PORT);
+    if (inject_faults) {
+        for (uint8_t port = 0; port < SIM_I2C_PORTS; port++) {
+            sim_i2c_set_fault_model(port, sim_i2c_line_faults, &line);
+        }
+    }
+
+    if (opts.trace && !sim_aht10_load_csv(opts.trace)) {
+        fprintf(stderr, "replay: traço inválido: %s\n", opts.trace);
+        return 2;
+    }
+
+    FILE* serial = open_output(opts.serial_path);
+    FILE* frames = open_output(opts.frames_path);
+    FILE* bus_log = open_output(opts.bus_log_path);
+    sim_serial_set_log(serial, false);
+    sim_serial_set_hook(on_serial_line);
+    sim_ssd1306_set_frame_log(frames);
+    sim_i2c_set_log(bus_log);
+
+    if (opts.button_period_s > 0) {
+        button_period_us = (uint64_t)(opts.button_period_s * SIM_US_PER_S);
+        sim_schedule(button_period_us, press_button, NULL);
+    }
+
+    if (!opts.quiet) printf("Transições de alerta (primeiras %d):\n", REPLAY_MAX_TRANSITIONS_SHOWN);
+    sim_set_end_us((uint64_t)(opts.duration_s * SIM_US_PER_S));
+
+    clock_t wall_start = clock();
+    if (sim_run(run_firmware) != 0) {
+        fprintf(stderr, "replay: firmware retornou antes do fim da simulação\n");
+        return 1;
+    }
+    double wall_s = (double)(clock() - wall_start) / CLOCKS_PER_SEC;
+
+    bool ok = print_report(wall_s);
+    if (sim_aht10_measurements() == 0 || main_get_loop_stats()->cycles == 0) {
+        printf("FALHA: nenhuma leitura do sensor\n");
+        ok = false;
+    }
+
+    FILE* outputs[] = {serial, frames, bus_log};
+    for (size_t i = 0; i < sizeof(outputs) / sizeof(outputs[0]); i++) {
+        if (outputs[i] && outputs[i] != stdout) fclose(outputs[i]);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+#ifndef SIM_H
+#define SIM_H
+
+// Simulação no host: relógio virtual, barramentos I2C e modelos de dispositivos.
+// O firmware é compilado sem alterações sobre os cabeçalhos de include/ e roda
+// dias de operação em segundos de CPU.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define SIM_US_PER_S   1000000ull
+#define SIM_US_PER_DAY (86400ull * SIM_US_PER_S)
+
+// ===== RELÓGIO VIRTUAL =====
+// Eventos agendados (bordas de GPIO, alarmes) disparam como IRQs quando o relógio passa por eles.
+typedef void (*sim_event_fn_t)(void* arg);
+// Chamado depois de cada avanço do relógio (ex.: detectar fim de quadro no display)
+typedef void (*sim_tick_hook_t)(uint64_t now_us);
+
+void sim_clock_reset(void);
+uint64_t sim_now_us(void);
+void sim_advance_to(uint64_t t_us);
+void sim_advance_us(uint64_t us);
+bool sim_schedule(uint64_t t_us, sim_event_fn_t fn, void* arg);
+void sim_cancel(sim_event_fn_t fn, void* arg);
+bool sim_next_event_us(uint64_t* t_us);
+void sim_add_tick_hook(sim_tick_hook_t hook);
+// Fim da simulação: ao atingir end_us o relógio retorna (longjmp) para sim_run
+void sim_set_end_us(uint64_t end_us);
+int sim_run(void (*entry)(void));
+
+// ===== PRNG DETERMINÍSTICO =====
+void sim_rand_seed(uint64_t seed);
+uint32_t sim_rand_u32(void);
+float sim_rand_unit(void);  // [0, 1)
+
+// ===== SERIAL =====
+typedef void (*sim_line_hook_t)(uint64_t t_us, const char* line);
+
+int sim_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+void sim_serial_set_log(FILE* log, bool echo);
+void sim_serial_set_hook(sim_line_hook_t hook);
+uint32_t sim_serial_lines(void);
+// Entrada do console: texto entregue a getchar_timeout_us a partir de t_us
+bool sim_serial_inject(uint64_t t_us, const char* text);
+
+// ===== I2C =====
+#define SIM_I2C_PORTS 2
+
+typedef struct {
+    uint8_t port;
+    uint8_t addr;
+    void* ctx;
+    // Retornam false para NACK
+    bool (*write)(void* ctx, const uint8_t* src, size_t len);
+    bool (*read)(void* ctx, uint8_t* dst, size_t len);
+} sim_i2c_device_t;
+
+// Falha injetada em uma transferência
+typedef enum {
+    SIM_I2C_OK = 0,
+    SIM_I2C_NACK,
+    SIM_I2C_TIMEOUT,
+} sim_i2c_fault_t;
+
+// Modelo de erro por porta: decide a falha de cada transferência (NULL = barramento ideal)
+typedef sim_i2c_fault_t (*sim_i2c_fault_model_t)(uint8_t port, uint32_t baudrate, void* ctx);
+
+// Modelo físico da linha: a subida (R x C dos pull-ups) precisa caber em ~30% do período de SCL.
+// Com folga a taxa de erro é base_error_rate; de 60% a 100% do orçamento cresce linearmente até 1.
+// Ex. com 50 pF: 2.2 kΩ (~95 ns) passa a 1 MHz, 4.7 kΩ (~200 ns) falha com frequência, 10 kΩ só até 400 kHz.
+typedef struct {
+    float rise_ns;          // Tempo de subida 10-90% (0.85 x R x C)
+    float base_error_rate;  // Erros por transferência independentes da velocidade (ruído)
+    float timeout_share;    // Fração dos erros que viram timeout (SCL preso) em vez de NACK
+} sim_i2c_line_t;
+
+float sim_i2c_line_error_rate(const sim_i2c_line_t* line, uint32_t baudrate);
+sim_i2c_fault_t sim_i2c_line_faults(uint8_t port, uint32_t baudrate, void* ctx);
+
+typedef struct {
+    uint32_t transactions;
+    uint64_t bytes;
+    uint32_t nacks;
+    uint32_t timeouts;
+    uint64_t busy_us;
+    uint32_t baud_changes;
+} sim_i2c_stats_t;
+
+void sim_i2c_reset(void);
+bool sim_i2c_attach(const sim_i2c_device_t* device);
+void sim_i2c_set_fault_model(uint8_t port, sim_i2c_fault_model_t model, void* ctx);
+void sim_i2c_set_log(FILE* log);
+const sim_i2c_stats_t* sim_i2c_get_stats(uint8_t port);
+uint32_t sim_i2c_get_baudrate(uint8_t port);
+
+// ===== GPIO =====
+void sim_gpio_reset(void);
+void sim_gpio_set_level(unsigned pin, bool level);
+// Pull-up externo nas linhas I2C (padrão: presente, como nos módulos AHT10/SSD1306)
+void sim_gpio_set_external_pullup(unsigned pin, bool present);
+// Pressionar o botão em t_us por hold_ms, com bounce_edges bordas espúrias em cada transição
+void sim_gpio_schedule_press(unsigned pin, uint64_t t_us, uint32_t hold_ms, uint32_t bounce_edges);
+
+// ===== FLASH =====
+void sim_flash_reset(void);
+uint32_t sim_flash_erase_count(void);
+
+// ===== AHT10 =====
+typedef struct {
+    float temperature;  // °C (bruto, antes da compensação do firmware)
+    float humidity;     // %
+} sim_aht10_sample_t;
+
+// calibrated = false modela clones que nunca ligam o bit de calibração no status
+void sim_aht10_attach(uint8_t port, bool calibrated);
+bool sim_aht10_load_csv(const char* path);
+void sim_aht10_use_synthetic(void);
+sim_aht10_sample_t sim_aht10_sample_at(uint64_t t_us);
+uint32_t sim_aht10_measurements(void);
+
+// ===== SSD1306 =====
+typedef struct {
+    uint32_t frames;          // Quadros distintos exibidos
+    uint64_t data_bytes;      // Bytes de GDDRAM recebidos
+    uint32_t command_writes;  // Transações de comando
+    bool display_on;
+    uint8_t contrast;
+} sim_ssd1306_stats_t;
+
+void sim_ssd1306_attach(uint8_t port);
+void sim_ssd1306_set_frame_log(FILE* log);
+const sim_ssd1306_stats_t* sim_ssd1306_get_stats(void);
+const uint8_t* sim_ssd1306_gddram(void);
+void sim_ssd1306_dump(FILE* out);
+
+#endif // SIM_H
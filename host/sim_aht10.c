@@ -0,0 +1,177 @@
+#include "sim.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "aht10.h"
+
+// ===== CONFIGURAÇÕES =====
+#define SIM_AHT10_MEASURE_US  75000  // Tempo típico de conversão (datasheet)
+#define SIM_AHT10_RESET_US    20000
+#define SIM_AHT10_MAX_POINTS  100000
+
+// Ciclo diário sintético (valores brutos, antes de AHT10_TEMP_COMPENSATION)
+#define SIM_SYNTH_TEMP_MEAN   24.3f
+#define SIM_SYNTH_TEMP_SWING  5.0f
+#define SIM_SYNTH_HUM_MEAN    55.0f
+#define SIM_SYNTH_HUM_SWING   10.0f
+#define SIM_SYNTH_NOISE       0.1f
+
+typedef struct {
+    double t_s;
+    sim_aht10_sample_t value;
+} sim_trace_point_t;
+
+// ===== VARIÁVEIS GLOBAIS =====
+static sim_trace_point_t* trace = NULL;
+static size_t trace_len = 0;
+
+static bool reports_calibrated = true;  // false = clone que nunca liga o bit de calibração
+static uint64_t busy_until_us = 0;
+static bool measuring = false;
+static uint8_t raw[5];
+static uint32_t measurements = 0;
+
+// ===== TRAÇO DE AMBIENTE =====
+
+// CSV: segundos,temperatura_c,umidade_pct (linhas com '#' ou cabeçalho são ignoradas).
+// O traço é repetido em laço, então um dia gravado cobre qualquer duração de replay.
+bool sim_aht10_load_csv(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+
+    free(trace);
+    trace = malloc(sizeof(*trace) * SIM_AHT10_MAX_POINTS);
+    trace_len = 0;
+    char line[256];
+    while (trace && trace_len < SIM_AHT10_MAX_POINTS && fgets(line, sizeof(line), f)) {
+        double t;
+        float temp, hum;
+        if (line[0] == '#' || sscanf(line, "%lf,%f,%f", &t, &temp, &hum) != 3) continue;
+        if (trace_len > 0 && t <= trace[trace_len - 1].t_s) continue;  // Exigir tempo crescente
+        trace[trace_len++] = (sim_trace_point_t){.t_s = t, .value = {temp, hum}};
+    }
+    fclose(f);
+
+    if (trace_len < 2) {
+        free(trace);
+        trace = NULL;
+        trace_len = 0;
+        return false;
+    }
+    return true;
+}
+
+void sim_aht10_use_synthetic(void) {
+    free(trace);
+    trace = NULL;
+    trace_len = 0;
+}
+
+sim_aht10_sample_t sim_aht10_sample_at(uint64_t t_us) {
+    double t_s = (double)t_us / SIM_US_PER_S;
+
+    if (!trace) {
+        // Mínimo às 03h, máximo às 15h; umidade em oposição de fase
+        double phase = 2.0 * M_PI * (fmod(t_s, 86400.0) / 86400.0 - 0.375);
+        float noise = (sim_rand_unit() - 0.5f) * 2.0f * SIM_SYNTH_NOISE;
+        return (sim_aht10_sample_t){
+            .temperature = SIM_SYNTH_TEMP_MEAN + SIM_SYNTH_TEMP_SWING * (float)sin(phase) + noise,
+            .humidity = SIM_SYNTH_HUM_MEAN - SIM_SYNTH_HUM_SWING * (float)sin(phase) + noise,
+        };
+    }
+
+    // Interpolação linear dentro do período do traço
+    double span = trace[trace_len - 1].t_s - trace[0].t_s;
+    double t = trace[0].t_s + fmod(t_s, span);
+    size_t i = 1;
+    while (i < trace_len - 1 && trace[i].t_s < t) i++;
+    const sim_trace_point_t* a = &trace[i - 1];
+    const sim_trace_point_t* b = &trace[i];
+    float k = (float)((t - a->t_s) / (b->t_s - a->t_s));
+    return (sim_aht10_sample_t){
+        .temperature = a->value.temperature + k * (b->value.temperature - a->value.temperature),
+        .humidity = a->value.humidity + k * (b->value.humidity - a->value.humidity),
+    };
+}
+
+// ===== MODELO DO DISPOSITIVO =====
+
+static void sim_aht10_latch(uint64_t t_us) {
+    sim_aht10_sample_t s = sim_aht10_sample_at(t_us);
+    float hum = s.humidity < 0.0f ? 0.0f : (s.humidity > 100.0f ? 100.0f : s.humidity);
+    uint32_t hum_raw = (uint32_t)(hum / 100.0f * 1048575.0f);
+    uint32_t temp_raw = (uint32_t)((s.temperature + 50.0f) / 200.0f * 1048575.0f);
+    raw[0] = (uint8_t)(hum_raw >> 12);
+    raw[1] = (uint8_t)(hum_raw >> 4);
+    raw[2] = (uint8_t)(((hum_raw & 0x0F) << 4) | ((temp_raw >> 16) & 0x0F));
+    raw[3] = (uint8_t)(temp_raw >> 8);
+    raw[4] = (uint8_t)temp_raw;
+    measurements++;
+}
+
+static uint8_t sim_aht10_status(void) {
+    uint64_t now = sim_now_us();
+    if (measuring && now >= busy_until_us) {
+        // Conversão concluída: dados refletem o ambiente no fim da medição
+        sim_aht10_latch(busy_until_us);
+        measuring = false;
+    }
+    uint8_t status = 0;
+    if (now < busy_until_us) status |= AHT10_STATUS_BUSY;
+    if (reports_calibrated) status |= AHT10_STATUS_CALIBRATED;
+    return status;
+}
+
+static bool sim_aht10_write(void* ctx, const uint8_t* src, size_t len) {
+    (void)ctx;
+    if (len == 0) return true;
+
+    switch (src[0]) {
+        case AHT10_CMD_TRIGGER:
+            if (len < 3 || src[1] != AHT10_TRIGGER_DATA1) return false;
+            sim_aht10_status();
+            measuring = true;
+            busy_until_us = sim_now_us() + SIM_AHT10_MEASURE_US;
+            return true;
+        case AHT10_CMD_SOFTRST:
+            measuring = false;
+            busy_until_us = sim_now_us() + SIM_AHT10_RESET_US;
+            return true;
+        case AHT10_CMD_INIT:
+        case AHT10_CMD_STATUS:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Toda leitura começa pelo byte de status, seguido dos 5 bytes da última medição
+static bool sim_aht10_read(void* ctx, uint8_t* dst, size_t len) {
+    (void)ctx;
+    if (len == 0) return true;
+    dst[0] = sim_aht10_status();
+    for (size_t i = 1; i < len; i++) {
+        dst[i] = (i - 1 < sizeof(raw)) ? raw[i - 1] : 0xFF;
+    }
+    return true;
+}
+
+void sim_aht10_attach(uint8_t port, bool calibrated) {
+    reports_calibrated = calibrated;
+    measuring = false;
+    busy_until_us = 0;
+    measurements = 0;
+    memset(raw, 0, sizeof(raw));
+
+    sim_i2c_device_t dev = {
+        .port = port,
+        .addr = AHT10_I2C_ADDR,
+        .write = sim_aht10_write,
+        .read = sim_aht10_read,
+    };
+    sim_i2c_attach(&dev);
+}
+
+uint32_t sim_aht10_measurements(void) {
+    return measurements;
+}
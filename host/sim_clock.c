@@ -0,0 +1,264 @@
+#include "sim.h"
+#include <setjmp.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+// ===== CONFIGURAÇÕES =====
+#define SIM_MAX_EVENTS 64
+#define SIM_MAX_HOOKS  8
+#define SIM_MAX_ALARMS 16
+
+typedef struct {
+    uint64_t t_us;
+    sim_event_fn_t fn;
+    void* arg;
+} sim_event_t;
+
+typedef struct {
+    bool active;
+    uint64_t due_us;
+    alarm_callback_t callback;
+    void* user_data;
+} sim_alarm_t;
+
+// ===== VARIÁVEIS GLOBAIS =====
+static uint64_t now_us = 0;
+static uint64_t end_us = 0;  // 0 = sem limite
+static sim_event_t events[SIM_MAX_EVENTS];
+static int event_count = 0;
+static sim_tick_hook_t hooks[SIM_MAX_HOOKS];
+static int hook_count = 0;
+static sim_alarm_t alarms[SIM_MAX_ALARMS];
+static jmp_buf exit_jmp;
+static bool running = false;
+static uint64_t rand_state = 0x9E3779B97F4A7C15ull;
+
+// ===== FUNÇÕES AUXILIARES =====
+
+static void sim_set_now(uint64_t t_us) {
+    if (t_us < now_us) return;
+    if (end_us && t_us >= end_us) {
+        now_us = end_us;
+        if (running) longjmp(exit_jmp, 1);
+        return;
+    }
+    now_us = t_us;
+    for (int i = 0; i < hook_count; i++) hooks[i](now_us);
+}
+
+// Retirar o evento mais antigo com horário <= limit
+static bool sim_pop_event(uint64_t limit, sim_event_t* out) {
+    int best = -1;
+    for (int i = 0; i < event_count; i++) {
+        if (events[i].t_us <= limit && (best < 0 || events[i].t_us < events[best].t_us)) best = i;
+    }
+    if (best < 0) return false;
+    *out = events[best];
+    events[best] = events[--event_count];
+    return true;
+}
+
+// ===== RELÓGIO VIRTUAL =====
+
+void sim_clock_reset(void) {
+    now_us = 0;
+    end_us = 0;
+    event_count = 0;
+    hook_count = 0;
+    memset(alarms, 0, sizeof(alarms));
+}
+
+uint64_t sim_now_us(void) {
+    return now_us;
+}
+
+// Avançar o relógio disparando, em ordem, os eventos no caminho
+void sim_advance_to(uint64_t t_us) {
+    sim_event_t ev;
+    while (sim_pop_event(t_us, &ev)) {
+        sim_set_now(ev.t_us);
+        ev.fn(ev.arg);
+    }
+    sim_set_now(t_us);
+}
+
+void sim_advance_us(uint64_t us) {
+    sim_advance_to(now_us + us);
+}
+
+bool sim_schedule(uint64_t t_us, sim_event_fn_t fn, void* arg) {
+    if (event_count >= SIM_MAX_EVENTS) return false;
+    events[event_count++] = (sim_event_t){.t_us = t_us < now_us ? now_us : t_us, .fn = fn, .arg = arg};
+    return true;
+}
+
+void sim_cancel(sim_event_fn_t fn, void* arg) {
+    for (int i = 0; i < event_count; ) {
+        if (events[i].fn == fn && events[i].arg == arg) {
+            events[i] = events[--event_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+bool sim_next_event_us(uint64_t* t_us) {
+    if (event_count == 0) return false;
+    uint64_t best = events[0].t_us;
+    for (int i = 1; i < event_count; i++) {
+        if (events[i].t_us < best) best = events[i].t_us;
+    }
+    *t_us = best;
+    return true;
+}
+
+void sim_add_tick_hook(sim_tick_hook_t hook) {
+    if (hook_count < SIM_MAX_HOOKS) hooks[hook_count++] = hook;
+}
+
+void sim_set_end_us(uint64_t t_us) {
+    end_us = t_us;
+}
+
+// Executar o firmware até o fim da simulação. Retorna 0 ao atingir end_us,
+// 1 se entry retornou sozinho.
+int sim_run(void (*entry)(void)) {
+    if (setjmp(exit_jmp)) {
+        running = false;
+        return 0;
+    }
+    running = true;
+    entry();
+    running = false;
+    return 1;
+}
+
+// ===== PRNG (xorshift64*) =====
+
+void sim_rand_seed(uint64_t seed) {
+    rand_state = seed ? seed : 0x9E3779B97F4A7C15ull;
+}
+
+uint32_t sim_rand_u32(void) {
+    rand_state ^= rand_state >> 12;
+    rand_state ^= rand_state << 25;
+    rand_state ^= rand_state >> 27;
+    return (uint32_t)((rand_state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+float sim_rand_unit(void) {
+    return (float)(sim_rand_u32() >> 8) / 16777216.0f;
+}
+
+// ===== API DE TEMPO DO SDK =====
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)now_us;
+}
+
+absolute_time_t get_absolute_time(void) {
+    return now_us;
+}
+
+uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000);
+}
+
+uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+absolute_time_t from_us_since_boot(uint64_t us) {
+    return us;
+}
+
+absolute_time_t delayed_by_ms(absolute_time_t t, uint32_t ms) {
+    return t + (uint64_t)ms * 1000;
+}
+
+absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) {
+    return t + us;
+}
+
+absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return now_us + (uint64_t)ms * 1000;
+}
+
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+    return (int64_t)(to - from);
+}
+
+bool time_reached(absolute_time_t t) {
+    return now_us >= t;
+}
+
+void sleep_ms(uint32_t ms) {
+    sim_advance_us((uint64_t)ms * 1000);
+}
+
+void sleep_us(uint64_t us) {
+    sim_advance_us(us);
+}
+
+void sleep_until(absolute_time_t t) {
+    sim_advance_to(t);
+}
+
+// ===== ALARMES =====
+
+// Disparo do alarme no contexto de "IRQ" do timer (durante o avanço do relógio)
+static void sim_alarm_fire(void* arg) {
+    sim_alarm_t* alarm = arg;
+    if (!alarm->active) return;
+    alarm_id_t id = (alarm_id_t)(alarm - alarms) + 1;
+    alarm->active = false;
+
+    int64_t again = alarm->callback(id, alarm->user_data);
+    if (again != 0 && !alarm->active) {
+        alarm->due_us = again > 0 ? alarm->due_us + (uint64_t)again : now_us + (uint64_t)(-again);
+        alarm->active = true;
+        sim_schedule(alarm->due_us, sim_alarm_fire, alarm);
+    }
+}
+
+// ids começam em 1 (0 = disparou na hora, como no SDK)
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void* user_data, bool fire_if_past) {
+    (void)fire_if_past;
+    for (int i = 0; i < SIM_MAX_ALARMS; i++) {
+        if (alarms[i].active) continue;
+        alarms[i] = (sim_alarm_t){.active = true, .due_us = now_us + us, .callback = callback, .user_data = user_data};
+        if (!sim_schedule(alarms[i].due_us, sim_alarm_fire, &alarms[i])) {
+            alarms[i].active = false;
+            return -1;
+        }
+        return i + 1;
+    }
+    return -1;  // Pool esgotado
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void* user_data, bool fire_if_past) {
+    return add_alarm_in_us((uint64_t)ms * 1000, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    if (alarm_id < 1 || alarm_id > SIM_MAX_ALARMS || !alarms[alarm_id - 1].active) return false;
+    sim_alarm_t* alarm = &alarms[alarm_id - 1];
+    alarm->active = false;
+    sim_cancel(sim_alarm_fire, alarm);
+    return true;
+}
+
+// WFE: acordar no primeiro evento antes do prazo (false) ou no prazo (true)
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    uint64_t next;
+    if (sim_next_event_us(&next) && next < timeout_timestamp) {
+        sim_advance_to(next);
+        return false;
+    }
+    sim_advance_to(timeout_timestamp);
+    return true;
+}
@@ -0,0 +1,42 @@
+#include "sim.h"
+#include <string.h>
+#include "hardware/flash.h"
+#include "hardware/structs/clocks.h"
+#include "hardware/structs/scb.h"
+#include "hardware/uart.h"
+
+// ===== VARIÁVEIS GLOBAIS =====
+uint8_t sim_flash[PICO_FLASH_SIZE_BYTES];
+clocks_hw_t sim_clocks_hw = {.wake_en0 = 0xFFFFFFFFu, .wake_en1 = 0xFFFFFFFFu,
+                             .sleep_en0 = 0xFFFFFFFFu, .sleep_en1 = 0xFFFFFFFFu};
+armv6m_scb_hw_t sim_scb_hw;
+uart_inst_t sim_uart_inst[2] = {{0}, {1}};
+
+static uint32_t erase_count = 0;
+
+// ===== API DO SIMULADOR =====
+
+void sim_flash_reset(void) {
+    memset(sim_flash, 0xFF, sizeof(sim_flash));
+    erase_count = 0;
+}
+
+uint32_t sim_flash_erase_count(void) {
+    return erase_count;
+}
+
+// ===== API DE FLASH DO SDK =====
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    if (flash_offs % FLASH_SECTOR_SIZE || count % FLASH_SECTOR_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) return;
+    memset(&sim_flash[flash_offs], 0xFF, count);
+    erase_count++;
+}
+
+// Programar só limpa bits (1 -> 0), como na NOR flash real
+void flash_range_program(uint32_t flash_offs, const uint8_t* data, size_t count) {
+    if (flash_offs % FLASH_PAGE_SIZE || count % FLASH_PAGE_SIZE || flash_offs + count > PICO_FLASH_SIZE_BYTES) return;
+    for (size_t i = 0; i < count; i++) {
+        sim_flash[flash_offs + i] &= data[i];
+    }
+}
@@ -0,0 +1,111 @@
+#include "sim.h"
+#include <stdlib.h>
+#include "hardware/gpio.h"
+
+// ===== CONFIGURAÇÕES =====
+#define SIM_GPIO_PINS        30
+#define SIM_BOUNCE_PERIOD_US 300  // Intervalo entre bordas espúrias do contato
+
+typedef struct {
+    unsigned pin;
+    bool level;
+} sim_edge_t;
+
+// ===== VARIÁVEIS GLOBAIS =====
+static bool levels[SIM_GPIO_PINS];
+static uint32_t irq_mask[SIM_GPIO_PINS];
+static bool pulled_down[SIM_GPIO_PINS];
+static bool external_pullup[SIM_GPIO_PINS];  // Resistor no módulo/placa (I2C)
+static gpio_irq_callback_t irq_callback = NULL;
+
+// ===== FUNÇÕES AUXILIARES =====
+
+static void sim_gpio_edge_event(void* arg) {
+    sim_edge_t* edge = arg;
+    sim_gpio_set_level(edge->pin, edge->level);
+    free(edge);
+}
+
+static void sim_gpio_schedule_level(unsigned pin, uint64_t t_us, bool level) {
+    sim_edge_t* edge = malloc(sizeof(*edge));
+    if (!edge) return;
+    *edge = (sim_edge_t){.pin = pin, .level = level};
+    if (!sim_schedule(t_us, sim_gpio_edge_event, edge)) free(edge);
+}
+
+// Transição com bounce: alterna o nível e termina estável em level
+static uint64_t sim_gpio_schedule_transition(unsigned pin, uint64_t t_us, bool level, uint32_t bounce_edges) {
+    for (uint32_t i = 0; i < bounce_edges * 2; i++) {
+        sim_gpio_schedule_level(pin, t_us, (i % 2) ? !level : level);
+        t_us += SIM_BOUNCE_PERIOD_US;
+    }
+    sim_gpio_schedule_level(pin, t_us, level);
+    return t_us;
+}
+
+// ===== API DO SIMULADOR =====
+
+void sim_gpio_reset(void) {
+    for (int pin = 0; pin < SIM_GPIO_PINS; pin++) {
+        levels[pin] = true;  // Entradas com pull-up em repouso
+        irq_mask[pin] = 0;
+        pulled_down[pin] = false;
+        external_pullup[pin] = true;
+    }
+    irq_callback = NULL;
+}
+
+// Mudar o nível de um pino e disparar a IRQ da borda correspondente
+void sim_gpio_set_level(unsigned pin, bool level) {
+    if (pin >= SIM_GPIO_PINS || levels[pin] == level) return;
+    levels[pin] = level;
+    uint32_t event = level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+    if ((irq_mask[pin] & event) && irq_callback) {
+        irq_callback(pin, event);
+    }
+}
+
+void sim_gpio_set_external_pullup(unsigned pin, bool present) {
+    if (pin < SIM_GPIO_PINS) external_pullup[pin] = present;
+}
+
+void sim_gpio_schedule_press(unsigned pin, uint64_t t_us, uint32_t hold_ms, uint32_t bounce_edges) {
+    uint64_t pressed_us = sim_gpio_schedule_transition(pin, t_us, false, bounce_edges);
+    sim_gpio_schedule_transition(pin, pressed_us + (uint64_t)hold_ms * 1000, true, bounce_edges);
+}
+
+// ===== API GPIO DO SDK =====
+
+void gpio_init(uint gpio) { (void)gpio; }
+void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+void gpio_pull_up(uint gpio) {
+    if (gpio < SIM_GPIO_PINS) pulled_down[gpio] = false;
+}
+
+void gpio_pull_down(uint gpio) {
+    if (gpio < SIM_GPIO_PINS) pulled_down[gpio] = true;
+}
+void gpio_set_drive_strength(uint gpio, enum gpio_drive_strength drive) { (void)gpio; (void)drive; }
+void gpio_set_slew_rate(uint gpio, enum gpio_slew_rate slew) { (void)gpio; (void)slew; }
+
+// Com pull-down interno e sem resistor externo a linha cai para 0
+bool gpio_get(uint gpio) {
+    if (gpio >= SIM_GPIO_PINS) return false;
+    if (pulled_down[gpio] && !external_pullup[gpio]) return false;
+    return levels[gpio];
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t events, bool enabled) {
+    if (gpio >= SIM_GPIO_PINS) return;
+    if (enabled) {
+        irq_mask[gpio] |= events;
+    } else {
+        irq_mask[gpio] &= ~events;
+    }
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t events, bool enabled, gpio_irq_callback_t callback) {
+    irq_callback = callback;
+    gpio_set_irq_enabled(gpio, events, enabled);
+}
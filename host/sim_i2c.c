@@ -0,0 +1,159 @@
+#include "sim.h"
+#include "hardware/i2c.h"
+
+// ===== CONFIGURAÇÕES =====
+#define SIM_I2C_MAX_DEVICES  8
+#define SIM_SYS_CLOCK_HZ     125000000u  // clk_sys padrão do RP2040
+#define SIM_I2C_FRAME_BITS   2           // START + STOP
+#define SIM_RISE_BUDGET      0.3f        // Fração do período de SCL disponível para a subida
+#define SIM_RISE_MARGIN      0.6f        // Acima desta fração do orçamento os erros começam
+
+// ===== VARIÁVEIS GLOBAIS =====
+i2c_inst_t sim_i2c_inst[2] = {{.index = 0}, {.index = 1}};
+
+static sim_i2c_device_t devices[SIM_I2C_MAX_DEVICES];
+static int device_count = 0;
+static sim_i2c_fault_model_t fault_models[SIM_I2C_PORTS];
+static void* fault_ctx[SIM_I2C_PORTS];
+static sim_i2c_stats_t port_stats[SIM_I2C_PORTS];
+static FILE* bus_log = NULL;
+
+// ===== FUNÇÕES AUXILIARES =====
+
+static const sim_i2c_device_t* sim_i2c_find(uint8_t port, uint8_t addr) {
+    for (int i = 0; i < device_count; i++) {
+        if (devices[i].port == port && devices[i].addr == addr) return &devices[i];
+    }
+    return NULL;
+}
+
+// Tempo de barramento: 9 clocks por byte (endereço incluído) + START/STOP
+static uint64_t sim_i2c_duration_us(uint32_t baudrate, size_t bytes) {
+    uint64_t bits = (uint64_t)bytes * 9 + SIM_I2C_FRAME_BITS;
+    return (bits * SIM_US_PER_S + baudrate - 1) / baudrate;
+}
+
+static int sim_i2c_transfer(i2c_inst_t* i2c, uint8_t addr, uint8_t* buf, size_t len,
+                            bool is_read, uint timeout_us) {
+    uint8_t port = i2c->index;
+    sim_i2c_stats_t* stats = &port_stats[port];
+    const sim_i2c_device_t* dev = sim_i2c_find(port, addr);
+    uint64_t start_us = sim_now_us();
+    int ret;
+
+    sim_i2c_fault_t fault = fault_models[port] ? fault_models[port](port, i2c->baudrate, fault_ctx[port]) : SIM_I2C_OK;
+    if (fault == SIM_I2C_TIMEOUT) {
+        sim_advance_us(timeout_us);
+        stats->timeouts++;
+        ret = PICO_ERROR_TIMEOUT;
+    } else if (!dev || fault == SIM_I2C_NACK) {
+        // NACK no byte de endereço
+        sim_advance_us(sim_i2c_duration_us(i2c->baudrate, 1));
+        stats->nacks++;
+        ret = PICO_ERROR_GENERIC;
+    } else {
+        sim_advance_us(sim_i2c_duration_us(i2c->baudrate, len + 1));
+        bool ack = is_read ? dev->read(dev->ctx, buf, len) : dev->write(dev->ctx, buf, len);
+        if (ack) {
+            stats->bytes += len;
+            ret = (int)len;
+        } else {
+            stats->nacks++;
+            ret = PICO_ERROR_GENERIC;
+        }
+    }
+
+    stats->transactions++;
+    stats->busy_us += sim_now_us() - start_us;
+    if (bus_log) {
+        fprintf(bus_log, "%llu i2c%u 0x%02X %c %u %d\n", (unsigned long long)start_us, port, addr,
+                is_read ? 'R' : 'W', (unsigned)len, ret);
+    }
+    return ret;
+}
+
+// ===== API DO SIMULADOR =====
+
+void sim_i2c_reset(void) {
+    device_count = 0;
+    for (int port = 0; port < SIM_I2C_PORTS; port++) {
+        fault_models[port] = NULL;
+        fault_ctx[port] = NULL;
+        port_stats[port] = (sim_i2c_stats_t){0};
+        sim_i2c_inst[port].baudrate = 0;
+    }
+}
+
+bool sim_i2c_attach(const sim_i2c_device_t* device) {
+    if (device_count >= SIM_I2C_MAX_DEVICES || device->port >= SIM_I2C_PORTS) return false;
+    devices[device_count++] = *device;
+    return true;
+}
+
+void sim_i2c_set_fault_model(uint8_t port, sim_i2c_fault_model_t model, void* ctx) {
+    fault_models[port] = model;
+    fault_ctx[port] = ctx;
+}
+
+void sim_i2c_set_log(FILE* log) {
+    bus_log = log;
+}
+
+const sim_i2c_stats_t* sim_i2c_get_stats(uint8_t port) {
+    return &port_stats[port];
+}
+
+uint32_t sim_i2c_get_baudrate(uint8_t port) {
+    return sim_i2c_inst[port].baudrate;
+}
+
+// ===== MODELO DE ERROS =====
+
+float sim_i2c_line_error_rate(const sim_i2c_line_t* line, uint32_t baudrate) {
+    float budget_ns = SIM_RISE_BUDGET * 1e9f / (float)baudrate;
+    float margin = line->rise_ns / budget_ns;
+    float edge_rate = margin <= SIM_RISE_MARGIN ? 0.0f :
+                      (margin >= 1.0f ? 1.0f : (margin - SIM_RISE_MARGIN) / (1.0f - SIM_RISE_MARGIN));
+    float rate = line->base_error_rate + edge_rate;
+    return rate > 1.0f ? 1.0f : rate;
+}
+
+sim_i2c_fault_t sim_i2c_line_faults(uint8_t port, uint32_t baudrate, void* ctx) {
+    (void)port;
+    const sim_i2c_line_t* line = ctx;
+    if (sim_rand_unit() >= sim_i2c_line_error_rate(line, baudrate)) return SIM_I2C_OK;
+    return sim_rand_unit() < line->timeout_share ? SIM_I2C_TIMEOUT : SIM_I2C_NACK;
+}
+
+// ===== API I2C DO SDK =====
+
+// Mesmo arredondamento do SDK: período inteiro de clk_sys
+uint i2c_set_baudrate(i2c_inst_t* i2c, uint baudrate) {
+    uint32_t period = (SIM_SYS_CLOCK_HZ + baudrate / 2) / baudrate;
+    uint32_t actual = SIM_SYS_CLOCK_HZ / period;
+    if (actual != i2c->baudrate) port_stats[i2c->index].baud_changes++;
+    i2c->baudrate = actual;
+    return actual;
+}
+
+uint i2c_init(i2c_inst_t* i2c, uint baudrate) {
+    return i2c_set_baudrate(i2c, baudrate);
+}
+
+int i2c_write_timeout_us(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop, uint timeout_us) {
+    (void)nostop;
+    return sim_i2c_transfer(i2c, addr, (uint8_t*)src, len, false, timeout_us);
+}
+
+int i2c_read_timeout_us(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop, uint timeout_us) {
+    (void)nostop;
+    return sim_i2c_transfer(i2c, addr, dst, len, true, timeout_us);
+}
+
+int i2c_write_blocking(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop) {
+    return i2c_write_timeout_us(i2c, addr, src, len, nostop, 1000000);
+}
+
+int i2c_read_blocking(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop) {
+    return i2c_read_timeout_us(i2c, addr, dst, len, nostop, 1000000);
+}
@@ -0,0 +1,10 @@
+// Incluído à força (-include) nas fontes do firmware: redireciona printf para a serial simulada
+#ifndef SIM_PRINTF_H
+#define SIM_PRINTF_H
+
+#include <stdio.h>
+
+int sim_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+#define printf sim_printf
+
+#endif // SIM_PRINTF_H
@@ -0,0 +1,182 @@
+#include "sim.h"
+#include <string.h>
+
+// ===== CONFIGURAÇÕES =====
+#define SIM_SSD1306_ADDR      0x3C
+#define SIM_SSD1306_WIDTH     128
+#define SIM_SSD1306_PAGES     8
+#define SIM_SSD1306_GDDRAM    (SIM_SSD1306_WIDTH * SIM_SSD1306_PAGES)
+#define SIM_FRAME_SETTLE_US   5000  // Sem dados por este tempo = quadro completo
+
+// ===== VARIÁVEIS GLOBAIS =====
+static uint8_t gddram[SIM_SSD1306_GDDRAM];
+static uint8_t committed[SIM_SSD1306_GDDRAM];
+static sim_ssd1306_stats_t stats;
+static FILE* frame_log = NULL;
+
+// Janela de endereçamento horizontal (COLUMNADDR / PAGEADDR)
+static uint8_t col_start, col_end, page_start, page_end;
+static uint8_t col, page;
+
+// Comando em curso (argumentos podem chegar em transações separadas)
+static uint8_t cmd_opcode;
+static uint8_t cmd_args[2];
+static uint8_t cmd_args_needed = 0;
+static uint8_t cmd_args_received = 0;
+
+static bool dirty = false;
+static uint64_t last_data_us = 0;
+
+// ===== FUNÇÕES AUXILIARES =====
+
+static uint8_t sim_ssd1306_arg_count(uint8_t opcode) {
+    switch (opcode) {
+        case 0x21: case 0x22:                              // COLUMNADDR, PAGEADDR
+            return 2;
+        case 0x81: case 0x20: case 0xA8: case 0xD3:        // CONTRAST, MEMORYMODE, MULTIPLEX, OFFSET
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:        // CLOCKDIV, PRECHARGE, COMPINS, VCOMDETECT
+        case 0x8D:                                         // CHARGEPUMP
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static void sim_ssd1306_execute(void) {
+    switch (cmd_opcode) {
+        case 0x21:
+            col_start = col = cmd_args[0] & 0x7F;
+            col_end = cmd_args[1] & 0x7F;
+            break;
+        case 0x22:
+            page_start = page = cmd_args[0] & 0x07;
+            page_end = cmd_args[1] & 0x07;
+            break;
+        case 0x81:
+            stats.contrast = cmd_args[0];
+            break;
+        case 0xAE:
+            stats.display_on = false;
+            break;
+        case 0xAF:
+            stats.display_on = true;
+            break;
+        default:
+            break;
+    }
+}
+
+static void sim_ssd1306_command_byte(uint8_t byte) {
+    if (cmd_args_received < cmd_args_needed) {
+        cmd_args[cmd_args_received++] = byte;
+    } else {
+        cmd_opcode = byte;
+        cmd_args_needed = sim_ssd1306_arg_count(byte);
+        cmd_args_received = 0;
+    }
+    if (cmd_args_received == cmd_args_needed) {
+        sim_ssd1306_execute();
+        cmd_args_needed = cmd_args_received = 0;
+    }
+}
+
+// Modo horizontal: avança a coluna e quebra para a próxima página da janela
+static void sim_ssd1306_data_byte(uint8_t byte) {
+    gddram[page * SIM_SSD1306_WIDTH + col] = byte;
+    if (col++ >= col_end) {
+        col = col_start;
+        page = (page >= page_end) ? page_start : page + 1;
+    }
+}
+
+static void sim_ssd1306_log_frame(void) {
+    uint64_t t = sim_now_us();
+    fprintf(frame_log, "# quadro %lu t=%llu.%03llus %s contraste=0x%02X\n",
+            (unsigned long)stats.frames, (unsigned long long)(t / SIM_US_PER_S),
+            (unsigned long long)(t / 1000 % 1000), stats.display_on ? "ligado" : "desligado", stats.contrast);
+    sim_ssd1306_dump(frame_log);
+}
+
+// Quadro completo quando o barramento fica sem dados; só conta se a imagem mudou
+static void sim_ssd1306_tick(uint64_t now_us) {
+    if (!dirty || now_us - last_data_us < SIM_FRAME_SETTLE_US) return;
+    dirty = false;
+    if (memcmp(committed, gddram, sizeof(gddram)) == 0) return;
+    memcpy(committed, gddram, sizeof(gddram));
+    stats.frames++;
+    if (frame_log) sim_ssd1306_log_frame();
+}
+
+static bool sim_ssd1306_write(void* ctx, const uint8_t* src, size_t len) {
+    (void)ctx;
+    if (len == 0) return true;
+
+    if (src[0] == 0x40) {
+        for (size_t i = 1; i < len; i++) sim_ssd1306_data_byte(src[i]);
+        stats.data_bytes += len - 1;
+        dirty = true;
+        last_data_us = sim_now_us();
+    } else if (src[0] == 0x00) {
+        for (size_t i = 1; i < len; i++) sim_ssd1306_command_byte(src[i]);
+        stats.command_writes++;
+    } else {
+        return false;  // Byte de controle não suportado pelo driver
+    }
+    return true;
+}
+
+// O SSD1306 em I2C não permite leitura
+static bool sim_ssd1306_read(void* ctx, uint8_t* dst, size_t len) {
+    (void)ctx;
+    (void)dst;
+    (void)len;
+    return false;
+}
+
+// ===== API DO SIMULADOR =====
+
+void sim_ssd1306_attach(uint8_t port) {
+    memset(gddram, 0, sizeof(gddram));
+    memset(committed, 0, sizeof(committed));
+    stats = (sim_ssd1306_stats_t){.contrast = 0x7F};
+    col_start = col = 0;
+    col_end = SIM_SSD1306_WIDTH - 1;
+    page_start = page = 0;
+    page_end = SIM_SSD1306_PAGES - 1;
+    cmd_args_needed = cmd_args_received = 0;
+    dirty = false;
+
+    sim_i2c_device_t dev = {
+        .port = port,
+        .addr = SIM_SSD1306_ADDR,
+        .write = sim_ssd1306_write,
+        .read = sim_ssd1306_read,
+    };
+    sim_i2c_attach(&dev);
+    sim_add_tick_hook(sim_ssd1306_tick);
+}
+
+void sim_ssd1306_set_frame_log(FILE* log) {
+    frame_log = log;
+}
+
+const sim_ssd1306_stats_t* sim_ssd1306_get_stats(void) {
+    return &stats;
+}
+
+const uint8_t* sim_ssd1306_gddram(void) {
+    return gddram;
+}
+
+// Imagem da GDDRAM em texto (64 linhas x 128 colunas)
+void sim_ssd1306_dump(FILE* out) {
+    char row[SIM_SSD1306_WIDTH + 2];
+    for (int y = 0; y < SIM_SSD1306_PAGES * 8; y++) {
+        for (int x = 0; x < SIM_SSD1306_WIDTH; x++) {
+            row[x] = (gddram[(y / 8) * SIM_SSD1306_WIDTH + x] & (1u << (y % 8))) ? '#' : '.';
+        }
+        row[SIM_SSD1306_WIDTH] = '\n';
+        row[SIM_SSD1306_WIDTH + 1] = '\0';
+        fputs(row, out);
+    }
+}
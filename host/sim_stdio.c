@@ -0,0 +1,99 @@
+#include "sim.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+
+// ===== CONFIGURAÇÕES =====
+#define SIM_LINE_MAX     512
+#define SIM_INPUT_MAX    32
+
+typedef struct {
+    uint64_t t_us;
+    char* text;
+    size_t pos;
+} sim_input_t;
+
+// ===== VARIÁVEIS GLOBAIS =====
+static char line[SIM_LINE_MAX];
+static size_t line_len = 0;
+static uint32_t line_count = 0;
+static FILE* serial_log = NULL;
+static bool serial_echo = false;
+static sim_line_hook_t line_hook = NULL;
+static sim_input_t inputs[SIM_INPUT_MAX];
+static int input_count = 0;
+
+// ===== SAÍDA =====
+
+static void sim_serial_emit(void) {
+    line[line_len] = '\0';
+    line_count++;
+    uint64_t t = sim_now_us();
+    if (serial_log) {
+        fprintf(serial_log, "[%8llu.%03llu] %s\n",
+                (unsigned long long)(t / SIM_US_PER_S), (unsigned long long)(t / 1000 % 1000), line);
+    }
+    if (serial_echo) {
+        fprintf(stdout, "%s\n", line);
+    }
+    if (line_hook) line_hook(t, line);
+    line_len = 0;
+}
+
+// Substitui printf no firmware: captura a saída linha a linha com o horário virtual
+int sim_printf(const char* fmt, ...) {
+    char buf[SIM_LINE_MAX];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+
+    for (const char* p = buf; *p; p++) {
+        if (*p == '\n') {
+            sim_serial_emit();
+        } else if (line_len < SIM_LINE_MAX - 1) {
+            line[line_len++] = *p;
+        }
+    }
+    return n;
+}
+
+void sim_serial_set_log(FILE* log, bool echo) {
+    serial_log = log;
+    serial_echo = echo;
+}
+
+void sim_serial_set_hook(sim_line_hook_t hook) {
+    line_hook = hook;
+}
+
+uint32_t sim_serial_lines(void) {
+    return line_count;
+}
+
+// ===== ENTRADA =====
+
+bool sim_serial_inject(uint64_t t_us, const char* text) {
+    if (input_count >= SIM_INPUT_MAX) return false;
+    char* copy = malloc(strlen(text) + 1);
+    if (!copy) return false;
+    strcpy(copy, text);
+    inputs[input_count++] = (sim_input_t){.t_us = t_us, .text = copy, .pos = 0};
+    return true;
+}
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+// Sem espera real: o console só é lido sem bloqueio pelo firmware
+int getchar_timeout_us(uint32_t timeout_us) {
+    (void)timeout_us;
+    for (int i = 0; i < input_count; i++) {
+        sim_input_t* in = &inputs[i];
+        if (in->t_us > sim_now_us() || in->text[in->pos] == '\0') continue;
+        return (unsigned char)in->text[in->pos++];
+    }
+    return PICO_ERROR_TIMEOUT;
+}
@@ -0,0 +1,329 @@
+// Testes do display sobre o SSD1306 simulado: debounce do botão, rotação de páginas
+// e recuperação do espelho da GDDRAM após falhas de escrita.
+// Compilado também com LOW_POWER_MODE=1 (test_display_lowpower) para os estados do painel.
+
+#include "sim.h"
+#include <string.h>
+#include "aht10.h"
+#include "alerts.h"
+#include "display.h"
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+#define MS(ms) ((uint64_t)(ms) * 1000)
+#define DISPLAY_PORT 1
+
+// Falha roteirizada: deixar passar skip transferências e falhar as fail seguintes
+typedef struct {
+    uint32_t skip;
+    uint32_t fail;
+} test_faults_t;
+
+static int failures = 0;
+static test_faults_t faults;
+
+static sim_i2c_fault_t test_fault_model(uint8_t port, uint32_t baudrate, void* ctx) {
+    test_faults_t* f = ctx;
+    if (f->skip > 0) {
+        f->skip--;
+        return SIM_I2C_OK;
+    }
+    if (f->fail > 0) {
+        f->fail--;
+        return SIM_I2C_NACK;
+    }
+    return SIM_I2C_OK;
+}
+
+static uint32_t switches(void) {
+    return display_get_stats()->switches;
+}
+
+// Avançar o relógio atendendo o display como o loop principal (acorda em cada IRQ)
+static void run_for(uint64_t us) {
+    uint64_t end = sim_now_us() + us;
+    while (sim_now_us() < end) {
+        display_service();
+        uint64_t next;
+        sim_advance_to(sim_next_event_us(&next) && next < end ? next : end);
+    }
+    display_service();
+}
+
+// ===== TESTES =====
+
+static void test_press_with_bounce_counts_once(void) {
+    uint32_t before = switches();
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), 120, 4);
+    run_for(MS(500));
+    CHECK(switches() == before + 1);
+}
+
+static void test_long_hold_release_bounce_not_counted(void) {
+    // Soltura com bounce bem depois do toque (a trava de 200 ms na descida contava duas vezes)
+    uint32_t before = switches();
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), 800, 6);
+    run_for(MS(1500));
+    CHECK(switches() == before + 1);
+}
+
+static void test_short_glitch_ignored(void) {
+    uint32_t before = switches();
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), DISPLAY_BUTTON_DEBOUNCE_MS / 4, 0);
+    run_for(MS(500));
+    CHECK(switches() == before);
+}
+
+static void test_consecutive_presses(void) {
+    uint32_t before = switches();
+    for (int i = 0; i < 3; i++) {
+        sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), 100, 2);
+        run_for(MS(300));
+    }
+    CHECK(switches() == before + 3);
+}
+
+static void test_presses_between_services_not_lost(void) {
+    // Dois toques antes do loop atender: as duas páginas avançam
+    display_page_t page = display_get_page();
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), 100, 2);
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us() + MS(300), 100, 2);
+    sim_advance_us(MS(600));
+    display_service();
+    CHECK(display_get_page() == (display_page_t)((page + 2) % DISPLAY_PAGE_COUNT));
+}
+
+static void test_error_screen_suspends_rotation(void) {
+    uint8_t error_frame[1024];
+    aht10_data_t bad = {.valid = false};
+    display_update_sensor_data(bad);
+    memcpy(error_frame, sim_ssd1306_gddram(), sizeof(error_frame));
+
+    // Rotação e botão não podem redesenhar dados antigos por cima do erro
+    uint32_t before = switches();
+    run_for(MS(3 * DISPLAY_PAGE_CYCLE_MS));
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), 100, 2);
+    run_for(MS(500));
+    CHECK(switches() == before);
+    CHECK(memcmp(error_frame, sim_ssd1306_gddram(), sizeof(error_frame)) == 0);
+
+    // Leitura válida tira o erro da tela e a rotação volta
+    aht10_data_t good = {.temperature = 25.0f, .humidity = 48.0f, .valid = true};
+    display_update_sensor_data(good);
+    CHECK(memcmp(error_frame, sim_ssd1306_gddram(), sizeof(error_frame)) != 0);
+    run_for(MS(DISPLAY_PAGE_CYCLE_MS + 100));
+    CHECK(switches() == before + 1);
+}
+
+// Uma atualização com a transferência N falhando, repetida no barramento limpo, deve deixar
+// a GDDRAM igual ao quadro enviado inteiro (troca para a mesma página).
+// Temperatura e umidade mudam: duas linhas, cada uma com janela + dados.
+static void check_update_recovers_from_fault(uint32_t skip, float temperature, float humidity) {
+    uint8_t recovered[1024];
+    aht10_data_t data = {.temperature = temperature, .humidity = humidity, .valid = true};
+    
+    faults = (test_faults_t){.skip = skip, .fail = 1};
+    display_update_sensor_data(data);
+    CHECK(faults.fail == 0);  // A falha ocorreu dentro da atualização
+    faults = (test_faults_t){0};
+    
+    display_update_sensor_data(data);
+    memcpy(recovered, sim_ssd1306_gddram(), sizeof(recovered));
+    display_set_page(display_get_page());
+    CHECK(memcmp(recovered, sim_ssd1306_gddram(), sizeof(recovered)) == 0);
+}
+
+static void test_failed_data_write_is_resent(void) {
+    // Janela aceita, dados da primeira linha alterada com NACK
+    check_update_recovers_from_fault(1, 31.0f, 61.0f);
+}
+
+static void test_failed_window_does_not_misplace_data(void) {
+    // Janela da segunda linha alterada com NACK: os dados não podem cair na janela anterior
+    check_update_recovers_from_fault(2, 12.0f, 35.0f);
+}
+
+static void test_failed_page_switch_is_resent(void) {
+    uint8_t recovered[1024];
+    aht10_data_t data = {.temperature = 22.0f, .humidity = 40.0f, .valid = true};
+    
+    faults = (test_faults_t){.skip = 3, .fail = 1};
+    display_next_page();
+    faults = (test_faults_t){0};
+    
+    display_update_sensor_data(data);
+    memcpy(recovered, sim_ssd1306_gddram(), sizeof(recovered));
+    display_set_page(display_get_page());
+    CHECK(memcmp(recovered, sim_ssd1306_gddram(), sizeof(recovered)) == 0);
+}
+
+#if LOW_POWER_MODE
+// ===== ENERGIA DO PAINEL (modo de baixo consumo) =====
+
+static uint32_t display_transactions(void) {
+    return sim_i2c_get_stats(DISPLAY_PORT)->transactions;
+}
+
+static void test_idle_dims_then_turns_off(void) {
+    const sim_ssd1306_stats_t* panel = sim_ssd1306_get_stats();
+    display_wake();
+    CHECK(display_get_power() == DISPLAY_POWER_ON);
+    CHECK(panel->display_on && panel->contrast == DISPLAY_CONTRAST_NORMAL);
+    
+    run_for(MS(DISPLAY_IDLE_DIM_MS - 100));
+    CHECK(display_get_power() == DISPLAY_POWER_ON);
+    run_for(MS(200));
+    CHECK(display_get_power() == DISPLAY_POWER_DIM);
+    CHECK(panel->display_on && panel->contrast == DISPLAY_CONTRAST_DIM);
+    
+    // Esmaecido não gira páginas (sem tráfego além das atualizações)
+    uint32_t before = switches();
+    run_for(MS(DISPLAY_IDLE_OFF_MS - DISPLAY_IDLE_DIM_MS - 200));
+    CHECK(display_get_power() == DISPLAY_POWER_DIM);
+    CHECK(switches() == before);
+    run_for(MS(200));
+    CHECK(display_get_power() == DISPLAY_POWER_OFF);
+    CHECK(!panel->display_on);
+}
+
+static void test_no_traffic_while_off(void) {
+    const sim_ssd1306_stats_t* panel = sim_ssd1306_get_stats();
+    CHECK(display_get_power() == DISPLAY_POWER_OFF);
+    uint64_t data_bytes = panel->data_bytes;
+    uint32_t transactions = display_transactions();
+    
+    // Leituras, erro e rotação enquanto desligado: nenhum byte no barramento do display
+    aht10_data_t data = {.temperature = 30.0f, .humidity = 65.0f, .valid = true};
+    display_update_sensor_data(data);
+    aht10_data_t bad = {.valid = false};
+    display_update_sensor_data(bad);
+    display_update_sensor_data(data);
+    run_for(MS(3 * DISPLAY_PAGE_CYCLE_MS));
+    CHECK(display_get_power() == DISPLAY_POWER_OFF);
+    CHECK(panel->data_bytes == data_bytes);
+    CHECK(display_transactions() == transactions);
+}
+
+static void test_first_press_only_wakes(void) {
+    const sim_ssd1306_stats_t* panel = sim_ssd1306_get_stats();
+    uint8_t woken[1024];
+    CHECK(display_get_power() == DISPLAY_POWER_OFF);
+    display_page_t page = display_get_page();
+    uint32_t before = switches();
+    
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), 100, 2);
+    run_for(MS(300));
+    CHECK(display_get_power() == DISPLAY_POWER_ON);
+    CHECK(panel->display_on && panel->contrast == DISPLAY_CONTRAST_NORMAL);
+    CHECK(display_get_page() == page);
+    CHECK(switches() == before);
+    
+    // Religar mostra a última leitura recebida enquanto desligado (igual ao quadro inteiro)
+    memcpy(woken, sim_ssd1306_gddram(), sizeof(woken));
+    display_set_page(page);
+    CHECK(memcmp(woken, sim_ssd1306_gddram(), sizeof(woken)) == 0);
+    
+    // Com o painel ligado o toque volta a trocar de página
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), 100, 2);
+    run_for(MS(300));
+    CHECK(display_get_page() == (display_page_t)((page + 1) % DISPLAY_PAGE_COUNT));
+}
+
+static void test_press_while_dim_restores_contrast(void) {
+    const sim_ssd1306_stats_t* panel = sim_ssd1306_get_stats();
+    run_for(MS(DISPLAY_IDLE_DIM_MS + 100));
+    CHECK(display_get_power() == DISPLAY_POWER_DIM);
+    display_page_t page = display_get_page();
+    
+    sim_gpio_schedule_press(DISPLAY_BUTTON_PIN, sim_now_us(), 100, 2);
+    run_for(MS(300));
+    CHECK(display_get_power() == DISPLAY_POWER_ON);
+    CHECK(panel->contrast == DISPLAY_CONTRAST_NORMAL);
+    CHECK(display_get_page() == page);
+    
+    // O toque reinicia a contagem de inatividade e a página ganha um ciclo inteiro antes de girar
+    run_for(MS(DISPLAY_PAGE_CYCLE_MS - 500));
+    CHECK(display_get_page() == page);
+    run_for(MS(DISPLAY_IDLE_DIM_MS - DISPLAY_PAGE_CYCLE_MS));
+    CHECK(display_get_power() == DISPLAY_POWER_ON);
+}
+
+static void test_wake_from_alert(void) {
+    // main.c chama display_wake() quando uma regra acaba de ativar
+    const sim_ssd1306_stats_t* panel = sim_ssd1306_get_stats();
+    run_for(MS(DISPLAY_IDLE_OFF_MS + 100));
+    CHECK(display_get_power() == DISPLAY_POWER_OFF);
+    uint64_t data_bytes = panel->data_bytes;
+    aht10_data_t data = {.temperature = 35.0f, .humidity = 45.0f, .valid = true};
+    display_update_sensor_data(data);
+    CHECK(panel->data_bytes == data_bytes);
+    
+    display_wake();
+    CHECK(display_get_power() == DISPLAY_POWER_ON);
+    CHECK(panel->display_on && panel->contrast == DISPLAY_CONTRAST_NORMAL);
+    CHECK(panel->data_bytes > data_bytes);  // Leitura recebida desligado enviada ao religar
+    
+    run_for(MS(DISPLAY_IDLE_DIM_MS - 500));
+    CHECK(display_get_power() == DISPLAY_POWER_ON);
+}
+
+static void test_power_time_accounting(void) {
+    // O tempo por estado soma o tempo total (base do modelo de energia)
+    uint64_t total = 0;
+    for (int state = 0; state < DISPLAY_POWER_STATE_COUNT; state++) {
+        total += display_get_power_time_us((display_power_t)state);
+    }
+    CHECK(display_get_power_time_us(DISPLAY_POWER_DIM) > 0);
+    CHECK(display_get_power_time_us(DISPLAY_POWER_OFF) > 0);
+    CHECK(total <= sim_now_us());
+    CHECK(total + MS(2000) >= sim_now_us());  // Só o boot antes de display_init fica de fora
+}
+#endif
+
+int main(void) {
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_i2c_reset();
+    sim_flash_reset();
+    sim_ssd1306_attach(DISPLAY_PORT);
+    CHECK(display_init());
+    alerts_init();
+
+    aht10_data_t data = {.temperature = 24.0f, .humidity = 50.0f, .valid = true};
+    display_update_sensor_data(data);
+
+#if LOW_POWER_MODE
+    test_idle_dims_then_turns_off();
+    test_no_traffic_while_off();
+    test_first_press_only_wakes();
+    test_press_while_dim_restores_contrast();
+    test_wake_from_alert();
+    test_power_time_accounting();
+    display_wake();
+#endif
+
+    test_press_with_bounce_counts_once();
+    test_long_hold_release_bounce_not_counted();
+    test_short_glitch_ignored();
+    test_consecutive_presses();
+    test_presses_between_services_not_lost();
+    test_error_screen_suspends_rotation();
+    
+    sim_i2c_set_fault_model(DISPLAY_PORT, test_fault_model, &faults);
+    display_set_page(DISPLAY_PAGE_READING);
+    test_failed_data_write_is_resent();
+    test_failed_window_does_not_misplace_data();
+    test_failed_page_switch_is_resent();
+
+    if (failures) {
+        fprintf(stderr, "%d verificações falharam\n", failures);
+        return 1;
+    }
+    printf("test_display: ok\n");
+    return 0;
+}
@@ -0,0 +1,278 @@
+// Testes de i2c_bus sobre o barramento simulado: negociação, fallback por janela e backoff.
+
+#include "sim.h"
+#include "hardware/i2c.h"
+#include "aht10.h"
+#include "i2c_bus.h"
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+#define ECHO_ADDR 0x50
+#define BAUD_FAST 399361u  // 400 kHz após o arredondamento do divisor (clk_sys 125 MHz)
+#define MS(ms) ((uint64_t)(ms) * 1000)
+
+// Falhas roteirizadas: as próximas fail_next transferências e tudo acima de fail_above_baud
+typedef struct {
+    uint32_t fail_next;
+    uint32_t fail_above_baud;  // 0 = sem limite
+} test_faults_t;
+
+static int failures = 0;
+static test_faults_t faults;
+
+static sim_i2c_fault_t test_fault_model(uint8_t port, uint32_t baudrate, void* ctx) {
+    test_faults_t* f = ctx;
+    if (f->fail_next > 0) {
+        f->fail_next--;
+        return SIM_I2C_NACK;
+    }
+    if (f->fail_above_baud && baudrate > f->fail_above_baud) return SIM_I2C_NACK;
+    return SIM_I2C_OK;
+}
+
+// Dispositivo que confirma tudo
+static bool echo_write(void* ctx, const uint8_t* src, size_t len) { return true; }
+static bool echo_read(void* ctx, uint8_t* dst, size_t len) { return true; }
+
+static bool echo_probe(void) {
+    uint8_t byte = 0;
+    return i2c_bus_write(I2C_BUS_SENSOR, ECHO_ADDR, &byte, 1, false) == 1;
+}
+
+static void traffic(uint32_t count) {
+    uint8_t byte = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        i2c_bus_write(I2C_BUS_SENSOR, ECHO_ADDR, &byte, 1, false);
+    }
+}
+
+static void setup(void) {
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_i2c_reset();
+    faults = (test_faults_t){0};
+    sim_i2c_set_fault_model(0, test_fault_model, &faults);
+    sim_i2c_device_t echo = {.port = 0, .addr = ECHO_ADDR, .write = echo_write, .read = echo_read};
+    sim_i2c_attach(&echo);
+    i2c_bus_init(I2C_BUS_SENSOR, i2c0, 0, 1, I2C_BUS_SPEED_FAST);
+}
+
+// Avançar até at_us e rodar o serviço; retorna true se houve sondagem (tráfego) nele
+static bool service_at(uint64_t at_us) {
+    sim_advance_to(at_us);
+    uint32_t before = sim_i2c_get_stats(0)->transactions;
+    i2c_bus_service();
+    return sim_i2c_get_stats(0)->transactions != before;
+}
+
+// Provocar um fallback; retorna o instante do serviço (base do agendamento da nova tentativa)
+static uint64_t fall_back(void) {
+    faults.fail_next = I2C_BUS_FALLBACK_ERRORS;
+    traffic(I2C_BUS_FALLBACK_ERRORS);
+    uint64_t t = sim_now_us();
+    i2c_bus_service();
+    return t;
+}
+
+// Negociar em 1 MHz e cair para 400 kHz
+static uint64_t negotiate_and_fall_back(void) {
+    i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe);
+    return fall_back();
+}
+
+// ===== TESTES =====
+
+static void test_negotiate_steps_down(void) {
+    setup();
+    faults.fail_above_baud = I2C_BUS_SPEED_FAST;
+    CHECK(i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe) == BAUD_FAST);
+
+    setup();
+    faults.fail_above_baud = I2C_BUS_SPEED_STANDARD;
+    CHECK(i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe) == I2C_BUS_SPEED_STANDARD);
+
+    // Nenhuma velocidade passa: fica na mais lenta
+    setup();
+    faults.fail_above_baud = 1;
+    CHECK(i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe) == I2C_BUS_SPEED_STANDARD);
+
+    // Uma falha isolada em qualquer das I2C_BUS_PROBE_COUNT sondagens reprova o degrau
+    setup();
+    faults.fail_next = 1;
+    CHECK(i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe) == BAUD_FAST);
+}
+
+static void test_negotiate_caps_without_pullups(void) {
+    setup();
+    sim_gpio_set_external_pullup(1, false);
+    CHECK(i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe) == BAUD_FAST);
+    CHECK(!service_at(MS(10ull * I2C_BUS_RETRY_MAX_MS)));  // Limite definitivo: sem novas tentativas
+}
+
+static void test_negotiate_below_max_schedules_retry(void) {
+    setup();
+    faults.fail_above_baud = I2C_BUS_SPEED_FAST;
+    i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe);
+    uint64_t t = sim_now_us();
+    faults.fail_above_baud = 0;  // Ruído do boot passou
+
+    uint32_t upgrades = i2c_bus_get_stats(I2C_BUS_SENSOR)->upgrades;
+    CHECK(!service_at(t + MS(I2C_BUS_RETRY_MS) - 1));
+    CHECK(service_at(t + MS(I2C_BUS_RETRY_MS)));
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == I2C_BUS_SPEED_FAST_PLUS);
+    CHECK(i2c_bus_get_stats(I2C_BUS_SENSOR)->upgrades == upgrades + 1);
+}
+
+static void test_fallback_threshold(void) {
+    setup();
+    i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe);
+    uint32_t fallbacks = i2c_bus_get_stats(I2C_BUS_SENSOR)->fallbacks;
+
+    // Abaixo do limiar dentro da janela: mantém a velocidade
+    faults.fail_next = I2C_BUS_FALLBACK_ERRORS - 1;
+    traffic(I2C_BUS_FALLBACK_ERRORS - 1);
+    i2c_bus_service();
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == I2C_BUS_SPEED_FAST_PLUS);
+
+    // Erros em janelas diferentes não se somam
+    traffic(I2C_BUS_WINDOW);
+    faults.fail_next = I2C_BUS_FALLBACK_ERRORS - 1;
+    traffic(I2C_BUS_FALLBACK_ERRORS - 1);
+    i2c_bus_service();
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == I2C_BUS_SPEED_FAST_PLUS);
+    CHECK(i2c_bus_get_stats(I2C_BUS_SENSOR)->fallbacks == fallbacks);
+
+    // Atingir o limiar na mesma janela: desce um degrau
+    faults.fail_next = 1;
+    traffic(1);
+    i2c_bus_service();
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == BAUD_FAST);
+    CHECK(i2c_bus_get_stats(I2C_BUS_SENSOR)->fallbacks == fallbacks + 1);
+
+    // Na velocidade mínima não há para onde descer
+    fall_back();
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == I2C_BUS_SPEED_STANDARD);
+    fall_back();
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == I2C_BUS_SPEED_STANDARD);
+}
+
+static void test_retry_backoff_doubles(void) {
+    setup();
+    uint64_t t = negotiate_and_fall_back();
+    faults.fail_above_baud = I2C_BUS_SPEED_FAST;  // 1 MHz continua ruim
+
+    uint64_t delay = I2C_BUS_RETRY_MS;
+    for (int attempt = 0; attempt < 6; attempt++) {
+        CHECK(!service_at(t + MS(delay) - 1));
+        CHECK(service_at(t + MS(delay)));
+        CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == BAUD_FAST);
+        t += MS(delay);
+        delay = (delay * 2 < I2C_BUS_RETRY_MAX_MS) ? delay * 2 : I2C_BUS_RETRY_MAX_MS;
+    }
+    CHECK(delay == I2C_BUS_RETRY_MAX_MS);
+}
+
+static void test_backoff_resets_after_clean_window(void) {
+    setup();
+    uint64_t t = negotiate_and_fall_back();
+    faults.fail_above_baud = I2C_BUS_SPEED_FAST;
+    CHECK(service_at(t + MS(I2C_BUS_RETRY_MS)));      // Falha: backoff vai para 2x
+    faults.fail_above_baud = 0;
+    CHECK(service_at(t + MS(3 * I2C_BUS_RETRY_MS)));  // Sobe para 1 MHz
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == I2C_BUS_SPEED_FAST_PLUS);
+
+    // Janela limpa a 1 MHz: backoff volta ao mínimo
+    traffic(I2C_BUS_WINDOW);
+    sim_advance_to(t + MS(4 * I2C_BUS_RETRY_MS));
+    t = fall_back();
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == BAUD_FAST);
+    CHECK(!service_at(t + MS(I2C_BUS_RETRY_MS) - 1));
+    CHECK(service_at(t + MS(I2C_BUS_RETRY_MS)));
+}
+
+static void test_upgrade_keeps_backoff_until_clean_window(void) {
+    setup();
+    uint64_t t = negotiate_and_fall_back();
+    faults.fail_above_baud = I2C_BUS_SPEED_FAST;
+    CHECK(service_at(t + MS(I2C_BUS_RETRY_MS)));      // Falha: 2x
+    faults.fail_above_baud = 0;
+    CHECK(service_at(t + MS(3 * I2C_BUS_RETRY_MS)));  // Sobe, ainda em observação
+
+    // Janela com um erro não confirma o upgrade; o fallback seguinte dobra de 2x para 4x
+    faults.fail_next = 1;
+    traffic(I2C_BUS_WINDOW);
+    sim_advance_to(t + MS(4 * I2C_BUS_RETRY_MS));
+    t = fall_back();
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == BAUD_FAST);
+    CHECK(!service_at(t + MS(4 * I2C_BUS_RETRY_MS) - 1));
+    CHECK(service_at(t + MS(4 * I2C_BUS_RETRY_MS)));
+}
+
+static void test_quick_refallback_doubles_backoff(void) {
+    setup();
+    uint64_t t = negotiate_and_fall_back();
+    CHECK(service_at(t + MS(I2C_BUS_RETRY_MS)));      // Sobe para 1 MHz
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == I2C_BUS_SPEED_FAST_PLUS);
+
+    // Cai de novo logo depois de subir: próxima tentativa só em 2x
+    sim_advance_to(t + MS(I2C_BUS_RETRY_MS + 1000));
+    t = fall_back();
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == BAUD_FAST);
+    CHECK(!service_at(t + MS(2 * I2C_BUS_RETRY_MS) - 1));
+    CHECK(service_at(t + MS(2 * I2C_BUS_RETRY_MS)));
+}
+
+static void test_line_model_by_baudrate(void) {
+    // 50 pF: 2.2 kΩ passa a 1 MHz, 4.7 kΩ não, 10 kΩ só até 400 kHz
+    sim_i2c_line_t strong = {.rise_ns = 95.0f};
+    sim_i2c_line_t medium = {.rise_ns = 200.0f};
+    sim_i2c_line_t weak = {.rise_ns = 425.0f};
+    CHECK(sim_i2c_line_error_rate(&strong, I2C_BUS_SPEED_FAST_PLUS) == 0.0f);
+    CHECK(sim_i2c_line_error_rate(&medium, I2C_BUS_SPEED_FAST_PLUS) > 0.05f);
+    CHECK(sim_i2c_line_error_rate(&medium, I2C_BUS_SPEED_FAST) == 0.0f);
+    CHECK(sim_i2c_line_error_rate(&weak, I2C_BUS_SPEED_FAST_PLUS) == 1.0f);
+    CHECK(sim_i2c_line_error_rate(&weak, I2C_BUS_SPEED_FAST) == 0.0f);
+
+    // Negociação sobre o modelo físico escolhe o degrau correspondente
+    setup();
+    sim_rand_seed(7);
+    sim_i2c_set_fault_model(0, sim_i2c_line_faults, &weak);
+    CHECK(i2c_bus_negotiate(I2C_BUS_SENSOR, I2C_BUS_SPEED_FAST_PLUS, echo_probe) == BAUD_FAST);
+}
+
+static void test_aht10_probe_ignores_calibration_bit(void) {
+    sim_clock_reset();
+    sim_gpio_reset();
+    sim_i2c_reset();
+    sim_aht10_attach(0, false);
+    CHECK(aht10_init());
+    CHECK(i2c_bus_get_baudrate(I2C_BUS_SENSOR) == I2C_BUS_SPEED_FAST_PLUS);
+
+    aht10_data_t data;
+    CHECK(aht10_read_data(&data) && data.valid);
+}
+
+int main(void) {
+    test_negotiate_steps_down();
+    test_negotiate_caps_without_pullups();
+    test_negotiate_below_max_schedules_retry();
+    test_fallback_threshold();
+    test_retry_backoff_doubles();
+    test_backoff_resets_after_clean_window();
+    test_upgrade_keeps_backoff_until_clean_window();
+    test_quick_refallback_doubles_backoff();
+    test_line_model_by_baudrate();
+    test_aht10_probe_ignores_calibration_bit();
+
+    if (failures) {
+        fprintf(stderr, "%d verificações falharam\n", failures);
+        return 1;
+    }
+    printf("test_i2c_bus: ok\n");
+    return 0;
+}
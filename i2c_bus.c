@@ -0,0 +1,270 @@
+#include "i2c_bus.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+
+// Degraus de velocidade usados na negociação e no fallback
+static const uint32_t i2c_bus_speeds[] = {
+    I2C_BUS_SPEED_FAST_PLUS,
+    I2C_BUS_SPEED_FAST,
+    I2C_BUS_SPEED_STANDARD,
+};
+#define I2C_BUS_SPEED_LEVELS (sizeof(i2c_bus_speeds) / sizeof(i2c_bus_speeds[0]))
+
+// Estado de cada barramento
+typedef struct {
+    const char* name;
+    i2c_inst_t* port;
+    uint sda_pin;
+    uint scl_pin;
+    uint32_t baudrate;        // Velocidade real programada no controlador
+    uint8_t speed_level;      // Degrau atual em i2c_bus_speeds
+    uint8_t max_level;        // Degrau mais rápido permitido para o dispositivo
+    i2c_bus_probe_t probe;
+    uint32_t window_transactions;
+    uint32_t window_errors;
+    uint64_t retry_at_us;     // Próxima tentativa de subir a velocidade (0 = nenhuma)
+    uint32_t retry_delay_ms;  // Backoff atual
+    bool probation;           // Subiu de velocidade e ainda não completou uma janela limpa
+    i2c_bus_stats_t stats;
+} i2c_bus_t;
+
+// ===== VARIÁVEIS GLOBAIS =====
+static i2c_bus_t buses[I2C_BUS_COUNT] = {
+    [I2C_BUS_SENSOR]  = {.name = "I2C0/AHT10"},
+    [I2C_BUS_DISPLAY] = {.name = "I2C1/SSD1306"},
+};
+
+// ===== FUNÇÕES AUXILIARES =====
+
+static uint8_t i2c_bus_level_for(uint32_t baudrate) {
+    for (uint8_t level = 0; level < I2C_BUS_SPEED_LEVELS; level++) {
+        if (i2c_bus_speeds[level] <= baudrate) return level;
+    }
+    return I2C_BUS_SPEED_LEVELS - 1;
+}
+
+static void i2c_bus_apply_speed(i2c_bus_t* b, uint8_t level) {
+    b->speed_level = level;
+    b->baudrate = i2c_set_baudrate(b->port, i2c_bus_speeds[level]);
+
+    // Pads em dreno aberto: corrente e slew só aceleram a borda de descida (Fm+ especifica
+    // corrente de dreno maior). A subida depende dos pull-ups externos, não dos pads.
+    bool fast_plus = i2c_bus_speeds[level] > I2C_BUS_SPEED_FAST;
+    enum gpio_drive_strength drive = fast_plus ? GPIO_DRIVE_STRENGTH_12MA : GPIO_DRIVE_STRENGTH_4MA;
+    enum gpio_slew_rate slew = fast_plus ? GPIO_SLEW_RATE_FAST : GPIO_SLEW_RATE_SLOW;
+    gpio_set_drive_strength(b->sda_pin, drive);
+    gpio_set_drive_strength(b->scl_pin, drive);
+    gpio_set_slew_rate(b->sda_pin, slew);
+    gpio_set_slew_rate(b->scl_pin, slew);
+
+    b->window_transactions = 0;
+    b->window_errors = 0;
+}
+
+// Trocar o pull-up interno por pull-down: só um resistor externo mantém SDA/SCL em nível alto
+static bool i2c_bus_has_external_pullups(const i2c_bus_t* b) {
+    uint pins[2] = {b->sda_pin, b->scl_pin};
+    bool high = true;
+
+    for (int i = 0; i < 2; i++) {
+        gpio_set_function(pins[i], GPIO_FUNC_SIO);
+        gpio_set_dir(pins[i], GPIO_IN);
+        gpio_pull_down(pins[i]);
+    }
+    sleep_us(I2C_BUS_PULLUP_SETTLE_US);
+    for (int i = 0; i < 2; i++) {
+        high = high && gpio_get(pins[i]);
+        gpio_pull_up(pins[i]);
+        gpio_set_function(pins[i], GPIO_FUNC_I2C);
+    }
+    return high;
+}
+
+// Executar a sondagem várias vezes; qualquer falha reprova a velocidade
+static bool i2c_bus_probe_level(i2c_bus_t* b, uint8_t level) {
+    i2c_bus_apply_speed(b, level);
+    for (int i = 0; i < I2C_BUS_PROBE_COUNT; i++) {
+        if (!b->probe()) return false;
+    }
+    return true;
+}
+
+// Dobrar o intervalo entre tentativas (limitado a I2C_BUS_RETRY_MAX_MS)
+static void i2c_bus_backoff(i2c_bus_t* b) {
+    b->retry_delay_ms = (b->retry_delay_ms * 2 < I2C_BUS_RETRY_MAX_MS) ? b->retry_delay_ms * 2 : I2C_BUS_RETRY_MAX_MS;
+}
+
+// Timeout proporcional ao tamanho da transferência (4x o tempo nominal + margem)
+static uint i2c_bus_timeout_us(const i2c_bus_t* b, size_t len) {
+    uint64_t bits = (uint64_t)(len + 1) * 9;  // endereço + dados, 9 clocks por byte
+    return (uint)(2000 + bits * 4000000 / b->baudrate);
+}
+
+static void i2c_bus_account(i2c_bus_t* b, int ret, uint64_t start_us) {
+    b->stats.transactions++;
+    b->stats.busy_us += time_us_64() - start_us;
+    b->window_transactions++;
+    if (ret < 0) {
+        b->stats.errors++;
+        b->window_errors++;
+        if (ret == PICO_ERROR_TIMEOUT) b->stats.timeouts++;
+    } else {
+        b->stats.bytes += (uint32_t)ret;
+    }
+
+    // Janela sem erros suficientes para fallback: começar nova janela
+    if (b->window_transactions >= I2C_BUS_WINDOW && b->window_errors < I2C_BUS_FALLBACK_ERRORS) {
+        // Primeira janela sem nenhum erro na velocidade nova: o upgrade se confirmou
+        if (b->probation && b->window_errors == 0) {
+            b->probation = false;
+            b->retry_delay_ms = I2C_BUS_RETRY_MS;
+        }
+        b->window_transactions = 0;
+        b->window_errors = 0;
+    }
+}
+
+// ===== FUNÇÕES PRINCIPAIS =====
+
+void i2c_bus_init(i2c_bus_id_t bus, i2c_inst_t* port, uint sda_pin, uint scl_pin, uint32_t baudrate) {
+    i2c_bus_t* b = &buses[bus];
+    b->port = port;
+    b->sda_pin = sda_pin;
+    b->scl_pin = scl_pin;
+    b->probe = NULL;
+    b->retry_at_us = 0;
+    b->retry_delay_ms = I2C_BUS_RETRY_MS;
+    b->probation = false;
+
+    i2c_init(port, baudrate);
+    gpio_set_function(sda_pin, GPIO_FUNC_I2C);
+    gpio_set_function(scl_pin, GPIO_FUNC_I2C);
+    gpio_pull_up(sda_pin);
+    gpio_pull_up(scl_pin);
+
+    uint8_t level = i2c_bus_level_for(baudrate);
+    b->max_level = level;
+    i2c_bus_apply_speed(b, level);
+}
+
+// Subir a velocidade até max_baudrate e descer degrau a degrau até a sondagem passar
+uint32_t i2c_bus_negotiate(i2c_bus_id_t bus, uint32_t max_baudrate, i2c_bus_probe_t probe) {
+    i2c_bus_t* b = &buses[bus];
+    b->probe = probe;
+    b->max_level = i2c_bus_level_for(max_baudrate);
+
+    printf("[I2C] Negociando velocidade em %s (máx. %lu Hz)...\n", b->name, (unsigned long)max_baudrate);
+
+    // Fast-mode Plus com os pull-ups internos não atende o tempo de subida: nem tentar
+    if (i2c_bus_speeds[b->max_level] > I2C_BUS_SPEED_FAST && !i2c_bus_has_external_pullups(b)) {
+        b->max_level = i2c_bus_level_for(I2C_BUS_SPEED_FAST);
+        printf("[I2C] ⚠️ %s sem pull-ups externos: limitado a %lu Hz (Fm+ requer ~2.2 kΩ ou menos)\n",
+               b->name, (unsigned long)I2C_BUS_SPEED_FAST);
+    }
+
+    bool found = false;
+    for (uint8_t level = b->max_level; level < I2C_BUS_SPEED_LEVELS && !found; level++) {
+        found = i2c_bus_probe_level(b, level);
+        if (found) {
+            printf("[I2C] ✅ %s operando a %lu Hz\n", b->name, (unsigned long)b->baudrate);
+        } else {
+            printf("[I2C] ⚠️ %s falhou a %lu Hz\n", b->name, (unsigned long)i2c_bus_speeds[level]);
+        }
+    }
+
+    if (!found) {
+        // Nenhuma velocidade passou: ficar na mais lenta e deixar o driver reportar a falha
+        i2c_bus_apply_speed(b, I2C_BUS_SPEED_LEVELS - 1);
+        printf("[I2C] ❌ %s sem resposta em nenhuma velocidade\n", b->name);
+    }
+
+    // Abaixo do limite (ex.: ruído no boot): i2c_bus_service tenta subir depois do backoff
+    b->retry_at_us = (b->speed_level > b->max_level) ? time_us_64() + (uint64_t)b->retry_delay_ms * 1000 : 0;
+    return b->baudrate;
+}
+
+// Chamado entre transações (ex.: uma vez por ciclo do loop principal).
+// Reduz a velocidade quando a taxa de erro sobe e tenta voltar mais tarde.
+void i2c_bus_service(void) {
+    uint64_t now_us = time_us_64();
+
+    for (int bus = 0; bus < I2C_BUS_COUNT; bus++) {
+        i2c_bus_t* b = &buses[bus];
+        if (!b->port || !b->probe) continue;
+
+        // Link degradado: descer um degrau e agendar nova tentativa
+        if (b->window_errors >= I2C_BUS_FALLBACK_ERRORS) {
+            if (b->speed_level + 1 >= I2C_BUS_SPEED_LEVELS) {
+                // Já na velocidade mínima: nada a reduzir, apenas reiniciar a janela
+                b->window_transactions = 0;
+                b->window_errors = 0;
+                continue;
+            }
+            uint32_t old_baudrate = b->baudrate;
+            uint32_t errors = b->window_errors;
+            uint32_t transactions = b->window_transactions;
+            i2c_bus_apply_speed(b, b->speed_level + 1);
+            b->stats.fallbacks++;
+            // Falhou logo depois de subir: a velocidade maior não se sustenta, esperar mais
+            if (b->probation) {
+                b->probation = false;
+                i2c_bus_backoff(b);
+            }
+            b->retry_at_us = now_us + (uint64_t)b->retry_delay_ms * 1000;
+            printf("[I2C] ⚠️ %s: %lu erros em %lu transações, reduzindo %lu -> %lu Hz\n",
+                   b->name, (unsigned long)errors, (unsigned long)transactions,
+                   (unsigned long)old_baudrate, (unsigned long)b->baudrate);
+            continue;
+        }
+
+        // Tentar recuperar a velocidade anterior depois do backoff
+        if (b->retry_at_us != 0 && now_us >= b->retry_at_us && b->speed_level > b->max_level) {
+            uint8_t level = b->speed_level;
+            if (i2c_bus_probe_level(b, level - 1)) {
+                // Backoff só volta ao mínimo depois de uma janela limpa (ver i2c_bus_account)
+                b->stats.upgrades++;
+                b->probation = true;
+                b->retry_at_us = (b->speed_level > b->max_level) ? now_us + (uint64_t)b->retry_delay_ms * 1000 : 0;
+                printf("[I2C] ✅ %s voltou a %lu Hz\n", b->name, (unsigned long)b->baudrate);
+            } else {
+                i2c_bus_apply_speed(b, level);
+                i2c_bus_backoff(b);
+                b->retry_at_us = now_us + (uint64_t)b->retry_delay_ms * 1000;
+                printf("[I2C] %s ainda instável a %lu Hz, nova tentativa em %lu s\n",
+                       b->name, (unsigned long)i2c_bus_speeds[level - 1],
+                       (unsigned long)(b->retry_delay_ms / 1000));
+            }
+        }
+    }
+}
+
+// Escrita com timeout e contabilização de tráfego (mesma semântica de i2c_write_blocking)
+int i2c_bus_write(i2c_bus_id_t bus, uint8_t addr, const uint8_t* src, size_t len, bool nostop) {
+    i2c_bus_t* b = &buses[bus];
+    uint64_t start_us = time_us_64();
+    int ret = i2c_write_timeout_us(b->port, addr, src, len, nostop, i2c_bus_timeout_us(b, len));
+    i2c_bus_account(b, ret, start_us);
+    return ret;
+}
+
+// Leitura com timeout e contabilização de tráfego (mesma semântica de i2c_read_blocking)
+int i2c_bus_read(i2c_bus_id_t bus, uint8_t addr, uint8_t* dst, size_t len, bool nostop) {
+    i2c_bus_t* b = &buses[bus];
+    uint64_t start_us = time_us_64();
+    int ret = i2c_read_timeout_us(b->port, addr, dst, len, nostop, i2c_bus_timeout_us(b, len));
+    i2c_bus_account(b, ret, start_us);
+    return ret;
+}
+
+const i2c_bus_stats_t* i2c_bus_get_stats(i2c_bus_id_t bus) {
+    return &buses[bus].stats;
+}
+
+const char* i2c_bus_get_name(i2c_bus_id_t bus) {
+    return buses[bus].name;
+}
+
+uint32_t i2c_bus_get_baudrate(i2c_bus_id_t bus) {
+    return buses[bus].baudrate;
+}
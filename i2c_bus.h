@@ -0,0 +1,57 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "hardware/i2c.h"
+
+// Velocidades suportadas (da mais rápida para a mais lenta)
+#define I2C_BUS_SPEED_FAST_PLUS  1000000  // Fast-mode Plus (exige pull-ups externos, ver abaixo)
+#define I2C_BUS_SPEED_FAST       400000   // Fast-mode
+#define I2C_BUS_SPEED_STANDARD   100000   // Standard-mode
+
+// Negociação e fallback
+#define I2C_BUS_PROBE_COUNT       8       // Sondagens consecutivas exigidas para aceitar uma velocidade
+#define I2C_BUS_WINDOW            64      // Transações por janela de medição de erros
+#define I2C_BUS_FALLBACK_ERRORS   3       // Erros na janela que disparam redução de velocidade
+#define I2C_BUS_RETRY_MS          60000   // Espera antes de tentar subir a velocidade novamente
+#define I2C_BUS_RETRY_MAX_MS      960000  // Limite do backoff exponencial de novas tentativas
+
+// As linhas são dreno aberto: a subida depende só de Rpull-up x Cbarramento. Fast-mode Plus
+// exige tr <= 120 ns, ou seja, ~2.2 kΩ ou menos com 50 pF; os pull-ups internos (~50 kΩ) não
+// servem. Sem pull-up externo detectado a negociação fica limitada a Fast-mode.
+#define I2C_BUS_PULLUP_SETTLE_US  50      // Espera para ler as linhas com pull-down interno
+
+// Barramentos I2C do projeto
+typedef enum {
+    I2C_BUS_SENSOR  = 0,  // I2C0 - AHT10
+    I2C_BUS_DISPLAY = 1,  // I2C1 - SSD1306
+    I2C_BUS_COUNT
+} i2c_bus_id_t;
+
+// Contadores de tráfego por barramento
+typedef struct {
+    uint32_t transactions;  // Transferências (escrita ou leitura)
+    uint32_t bytes;         // Bytes transferidos com sucesso
+    uint32_t errors;        // NACK / timeout
+    uint32_t timeouts;      // Subconjunto de errors causado por timeout
+    uint32_t fallbacks;     // Reduções automáticas de velocidade
+    uint32_t upgrades;      // Retornos bem-sucedidos a uma velocidade maior
+    uint64_t busy_us;       // Tempo total ocupado com transferências
+} i2c_bus_stats_t;
+
+// Sondagem do dispositivo: retorna true se respondeu corretamente (ACK / read-back)
+typedef bool (*i2c_bus_probe_t)(void);
+
+// Funções do barramento
+void i2c_bus_init(i2c_bus_id_t bus, i2c_inst_t* port, uint sda_pin, uint scl_pin, uint32_t baudrate);
+uint32_t i2c_bus_negotiate(i2c_bus_id_t bus, uint32_t max_baudrate, i2c_bus_probe_t probe);
+void i2c_bus_service(void);
+int i2c_bus_write(i2c_bus_id_t bus, uint8_t addr, const uint8_t* src, size_t len, bool nostop);
+int i2c_bus_read(i2c_bus_id_t bus, uint8_t addr, uint8_t* dst, size_t len, bool nostop);
+const i2c_bus_stats_t* i2c_bus_get_stats(i2c_bus_id_t bus);
+const char* i2c_bus_get_name(i2c_bus_id_t bus);
+uint32_t i2c_bus_get_baudrate(i2c_bus_id_t bus);
+
+#endif // I2C_BUS_H
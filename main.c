@@ -2,9 +2,100 @@
 #include "pico/stdlib.h"
 #include "aht10.h"
 #include "display.h"
+#include "alerts.h"
+#include "i2c_bus.h"
+#include "power.h"
+#include "main.h"
+
+// Agendamento do loop principal
+#define SAMPLE_INTERVAL_MS   2000  // Leitura a cada 2 segundos
+#define STATS_REPORT_SAMPLES 30    // Resumo de tráfego/prazos a cada 30 ciclos (~1 min)
+
+// Console serial (linhas de comando recebidas pelo stdio)
+#define CONSOLE_LINE_MAX 96
 
 // Variáveis globais
 static bool system_initialized = false;
+static loop_stats_t loop_stats;
+static char console_line[CONSOLE_LINE_MAX];
+static size_t console_len = 0;
+
+// Imprimir regras que mudaram de estado na última avaliação
+static void print_alert_transitions(const alert_state_t* alerts) {
+    const alert_rule_t* rules;
+    uint8_t count = alerts_get_rules(&rules);
+    
+    for (uint8_t i = 0; i < count; i++) {
+        if (!(alerts->changed_mask & (1u << i))) continue;
+        
+        bool active = alerts->active_mask & (1u << i);
+        printf("[ALERTAS] %s %s (%s %.1f, severidade %d)\n",
+               active ? "🚨 ATIVO:" : "✅ NORMALIZADO:",
+               rules[i].label,
+               rules[i].comparator == ALERT_CMP_BELOW ? "<" : ">",
+               rules[i].threshold,
+               rules[i].severity);
+    }
+}
+
+// Imprimir resumo de prazos, tráfego I2C e transições de alerta
+static void print_stats_report(void) {
+    uint64_t elapsed_us = time_us_64() - loop_stats.start_us;
+    if (elapsed_us == 0) return;
+    
+    printf("[STATS] Ciclos: %lu | Prazos perdidos: %lu | Pior ciclo: %lu us | Transições de alerta: %lu\n",
+           (unsigned long)loop_stats.cycles,
+           (unsigned long)loop_stats.missed_deadlines,
+           (unsigned long)loop_stats.worst_cycle_us,
+           (unsigned long)alerts_get_state()->transitions);
+    
+    power_report_t energy;
+    power_get_report(&energy);
+    printf("[STATS] Energia: CPU ativa %lu ms / dormindo %lu ms | média %.2f mA | consumo %.3f mAh | "
+           "autonomia estimada %.0f h (%.0f mAh)\n",
+           (unsigned long)(energy.cpu_active_us / 1000),
+           (unsigned long)(energy.cpu_sleep_us / 1000),
+           energy.avg_ma, energy.consumed_mah, energy.battery_hours, POWER_BATTERY_MAH);
+    
+    for (int bus = 0; bus < I2C_BUS_COUNT; bus++) {
+        const i2c_bus_stats_t* stats = i2c_bus_get_stats((i2c_bus_id_t)bus);
+        // Utilização em centésimos de % para evitar float no relatório
+        // (descontando o tráfego de inicialização/negociação anterior à janela)
+        uint32_t util_x100 = (uint32_t)((stats->busy_us - loop_stats.bus_busy_start_us[bus]) * 10000 / elapsed_us);
+        printf("[STATS] %s @ %lu Hz: %lu transações | %lu bytes | %lu erros (%lu timeouts) | "
+               "%lu fallbacks | utilização %lu.%02lu%%\n",
+               i2c_bus_get_name((i2c_bus_id_t)bus),
+               (unsigned long)i2c_bus_get_baudrate((i2c_bus_id_t)bus),
+               (unsigned long)stats->transactions,
+               (unsigned long)stats->bytes,
+               (unsigned long)stats->errors,
+               (unsigned long)stats->timeouts,
+               (unsigned long)stats->fallbacks,
+               (unsigned long)(util_x100 / 100),
+               (unsigned long)(util_x100 % 100));
+    }
+}
+
+const loop_stats_t* main_get_loop_stats(void) {
+    return &loop_stats;
+}
+
+// Ler o console sem bloquear e executar cada linha completa
+static void console_poll(void) {
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (c == '\r' || c == '\n') {
+            if (console_len == 0) continue;
+            console_line[console_len] = '\0';
+            console_len = 0;
+            if (!alerts_handle_command(console_line)) {
+                printf("Comando desconhecido: %s (use ALERTAS)\n", console_line);
+            }
+        } else if (console_len < CONSOLE_LINE_MAX - 1) {
+            console_line[console_len++] = (char)c;
+        }
+    }
+}
 
 int main() {
     stdio_init_all();
@@ -21,6 +112,9 @@ int main() {
     // Aguardar estabilização
     sleep_ms(1000);
     
+    // Bloquear clocks de periféricos não usados (modo de baixo consumo)
+    power_init();
+    
     // Inicializar display primeiro
     printf("\n--- INICIALIZANDO DISPLAY ---\n");
     bool display_ok = display_init();
@@ -57,53 +151,95 @@ int main() {
         }
     }
     
+    // Motor de alertas: carregar tabela (flash ou padrão) e medir custo por regra
+    printf("\n--- INICIALIZANDO ALERTAS ---\n");
+    alerts_init();
+    alerts_benchmark(1000);
+    
     system_initialized = true;
     printf("\n� SISTEMA PRONTO! Iniciando leituras...\n");
     printf("===============================================\n");
     printf("Formato: Temp | Umidade | Status\n");
     printf("===============================================\n");
     
-    // Contador para controle de display
-    uint32_t display_update_counter = 0;
-    const uint32_t DISPLAY_UPDATE_INTERVAL = 5; // Atualizar display a cada 5 leituras
+    // Prazos absolutos: o período não acumula o tempo de leitura/renderização
+    loop_stats.start_us = time_us_64();
+    for (int bus = 0; bus < I2C_BUS_COUNT; bus++) {
+        loop_stats.bus_busy_start_us[bus] = i2c_bus_get_stats((i2c_bus_id_t)bus)->busy_us;
+    }
+    absolute_time_t next_deadline = get_absolute_time();
     
     // Loop principal de leitura
     while (true) {
         aht10_data_t sensor_data;
+        absolute_time_t cycle_start = get_absolute_time();
+        next_deadline = delayed_by_ms(next_deadline, SAMPLE_INTERVAL_MS);
         
         // Ler dados do sensor
         bool read_success = aht10_read_data(&sensor_data);
         
         if (read_success && sensor_data.valid) {
-            // Determinar nível de conforto
-            const char* comfort = aht10_get_comfort_level(sensor_data.temperature, sensor_data.humidity);
+            // Avaliar regras uma única vez por amostra; display e serial usam o mesmo estado
+            bool alerts_changed = alerts_evaluate(&sensor_data, to_ms_since_boot(get_absolute_time()));
+            const alert_state_t* alerts = alerts_get_state();
             
-            // Imprimir no terminal
+            // Imprimir no terminal (temperatura compensada, a mesma avaliada pelas regras)
             printf("%.1f°C | %.1f%% | %s\n", 
-                   sensor_data.temperature, 
+                   alerts_get_metric(&sensor_data, ALERT_METRIC_TEMPERATURE), 
                    sensor_data.humidity, 
-                   comfort);
+                   alerts->status_label);
             
-            // Atualizar display periodicamente para evitar flickering
-            if (display_ok && (display_update_counter % DISPLAY_UPDATE_INTERVAL == 0)) {
-                display_update_sensor_data(sensor_data);
+            if (alerts_changed) {
+                print_alert_transitions(alerts);
+                
+                // Alerta recém-ativado acorda o display apagado/esmaecido
+                if (display_ok && (alerts->changed_mask & alerts->active_mask)) {
+                    display_wake();
+                }
             }
             
-            display_update_counter++;
+            // Atualizar display a cada leitura: só os campos dinâmicos alterados trafegam no I2C
+            if (display_ok) {
+                display_update_sensor_data(sensor_data);
+            }
         } else {
             printf("❌ Erro na leitura do sensor\n");
             
-            // Mostrar erro no display ocasionalmente
-            if (display_ok && (display_update_counter % DISPLAY_UPDATE_INTERVAL == 0)) {
+            // Mostrar erro no display (a próxima leitura válida redesenha a página)
+            if (display_ok) {
                 sensor_data.valid = false;
                 display_update_sensor_data(sensor_data);
             }
-            
-            display_update_counter++;
         }
         
-        // Aguardar antes da próxima leitura
-        sleep_ms(2000); // Leitura a cada 2 segundos
+        // Ajustar velocidade dos barramentos entre transações (fallback / nova tentativa)
+        i2c_bus_service();
+        
+        // Contabilizar tempo de trabalho e prazos perdidos
+        absolute_time_t now = get_absolute_time();
+        uint32_t cycle_us = (uint32_t)absolute_time_diff_us(cycle_start, now);
+        if (cycle_us > loop_stats.worst_cycle_us) {
+            loop_stats.worst_cycle_us = cycle_us;
+        }
+        loop_stats.cycles++;
+        
+        if (absolute_time_diff_us(now, next_deadline) < 0) {
+            // Atrasado: registrar e realinhar em vez de tentar recuperar ciclos
+            loop_stats.missed_deadlines++;
+            next_deadline = now;
+        }
+        
+        if (loop_stats.cycles % STATS_REPORT_SAMPLES == 0) {
+            print_stats_report();
+        }
+        
+        // Dormir até o próximo prazo; a IRQ do botão acorda o núcleo para trocar de página na hora
+        do {
+            if (display_ok) {
+                display_service();
+            }
+            console_poll();
+        } while (!power_sleep_until(next_deadline));
     }
     
     return 0;
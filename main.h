@@ -0,0 +1,19 @@
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <stdint.h>
+#include "i2c_bus.h"
+
+// Estatísticas de temporização do loop principal
+typedef struct {
+    uint32_t cycles;           // Ciclos executados
+    uint32_t missed_deadlines; // Ciclos que terminaram depois do próximo prazo
+    uint32_t worst_cycle_us;   // Maior tempo de trabalho em um ciclo
+    uint64_t start_us;         // Início da janela de medição
+    uint64_t bus_busy_start_us[I2C_BUS_COUNT];  // busy_us de cada barramento em start_us
+} loop_stats_t;
+
+// Leitura das estatísticas (ex.: replay no host)
+const loop_stats_t* main_get_loop_stats(void);
+
+#endif // MAIN_H
@@ -0,0 +1,108 @@
+#include "power.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/clocks.h"
+#include "hardware/structs/scb.h"
+#include "hardware/uart.h"
+#include "display.h"
+
+// ===== CONFIGURAÇÕES =====
+// Clocks de periféricos nunca usados pelo projeto (PIO, SPI, UART, PWM, ADC, RTC, JTAG, USB).
+// No modo de baixo consumo ficam desligados também com a CPU acordada.
+#define POWER_UNUSED_EN0 (CLOCKS_WAKE_EN0_CLK_SYS_PIO0_BITS | CLOCKS_WAKE_EN0_CLK_SYS_PIO1_BITS | \
+                          CLOCKS_WAKE_EN0_CLK_PERI_SPI0_BITS | CLOCKS_WAKE_EN0_CLK_SYS_SPI0_BITS | \
+                          CLOCKS_WAKE_EN0_CLK_PERI_SPI1_BITS | CLOCKS_WAKE_EN0_CLK_SYS_SPI1_BITS | \
+                          CLOCKS_WAKE_EN0_CLK_SYS_PWM_BITS | CLOCKS_WAKE_EN0_CLK_SYS_JTAG_BITS | \
+                          CLOCKS_WAKE_EN0_CLK_ADC_ADC_BITS | CLOCKS_WAKE_EN0_CLK_SYS_ADC_BITS | \
+                          CLOCKS_WAKE_EN0_CLK_RTC_RTC_BITS | CLOCKS_WAKE_EN0_CLK_SYS_RTC_BITS)
+// Com LOW_POWER_UART_STDIO a UART1 (stdio em GPIO 8/9) fica ligada enquanto a CPU está acordada.
+#if LOW_POWER_UART_STDIO
+#define POWER_UNUSED_UART (CLOCKS_WAKE_EN1_CLK_PERI_UART0_BITS | CLOCKS_WAKE_EN1_CLK_SYS_UART0_BITS)
+#else
+#define POWER_UNUSED_UART (CLOCKS_WAKE_EN1_CLK_PERI_UART0_BITS | CLOCKS_WAKE_EN1_CLK_SYS_UART0_BITS | \
+                           CLOCKS_WAKE_EN1_CLK_PERI_UART1_BITS | CLOCKS_WAKE_EN1_CLK_SYS_UART1_BITS)
+#endif
+#define POWER_UNUSED_EN1 (POWER_UNUSED_UART | \
+                          CLOCKS_WAKE_EN1_CLK_USB_USBCTRL_BITS | CLOCKS_WAKE_EN1_CLK_SYS_USBCTRL_BITS)
+
+// Durante o sono profundo só o necessário para acordar: timer (e seu tick do watchdog),
+// GPIO/pads para a IRQ do botão e o cristal
+#define POWER_SLEEP_EN0  (CLOCKS_SLEEP_EN0_CLK_SYS_IO_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_PADS_BITS)
+#define POWER_SLEEP_EN1  (CLOCKS_SLEEP_EN1_CLK_SYS_TIMER_BITS | CLOCKS_SLEEP_EN1_CLK_SYS_WATCHDOG_BITS | \
+                          CLOCKS_SLEEP_EN1_CLK_SYS_XOSC_BITS)
+
+// ===== VARIÁVEIS GLOBAIS =====
+static uint64_t sleep_total_us = 0;
+
+// ===== FUNÇÕES PRINCIPAIS =====
+
+void power_init(void) {
+#if LOW_POWER_MODE
+    clocks_hw->wake_en0 &= ~POWER_UNUSED_EN0;
+    clocks_hw->wake_en1 &= ~POWER_UNUSED_EN1;
+    printf("[ENERGIA] Modo de baixo consumo: clocks ociosos bloqueados, sono profundo entre amostras\n");
+#if LOW_POWER_UART_STDIO
+    printf("[ENERGIA] Relatórios pela UART1 (GPIO 8/9); comandos recebidos durante o sono são perdidos\n");
+#endif
+#else
+    printf("[ENERGIA] Modo normal (USB ativo, WFE entre amostras)\n");
+#endif
+}
+
+// Dormir até o prazo. Retorna true se o prazo foi atingido, false se uma IRQ
+// (ex.: botão) acordou a CPU antes - mesma semântica de best_effort_wfe_or_timeout.
+bool power_sleep_until(absolute_time_t deadline) {
+    uint64_t start_us = time_us_64();
+
+#if LOW_POWER_MODE
+#if LOW_POWER_UART_STDIO
+    // O clock da UART para no sono profundo: esvaziar o FIFO antes para não truncar a linha
+    uart_tx_wait_blocking(uart_default);
+#endif
+    // Com SLEEPDEEP, o WFE aplica SLEEP_EN0/1 e bloqueia os demais clocks até acordar
+    clocks_hw->sleep_en0 = POWER_SLEEP_EN0;
+    clocks_hw->sleep_en1 = POWER_SLEEP_EN1;
+    scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+#endif
+
+    bool reached = best_effort_wfe_or_timeout(deadline);
+
+#if LOW_POWER_MODE
+    scb_hw->scr &= ~M0PLUS_SCR_SLEEPDEEP_BITS;
+    clocks_hw->sleep_en0 = clocks_hw->wake_en0;
+    clocks_hw->sleep_en1 = clocks_hw->wake_en1;
+#endif
+
+    sleep_total_us += time_us_64() - start_us;
+    return reached;
+}
+
+// Modelo de energia: corrente por estado x tempo no estado
+void power_get_report(power_report_t* report) {
+    if (!report) return;
+
+    uint64_t now_us = time_us_64();
+    uint64_t sleep_us = sleep_total_us < now_us ? sleep_total_us : now_us;
+
+    report->uptime_us = now_us;
+    report->cpu_sleep_us = sleep_us;
+    report->cpu_active_us = now_us - sleep_us;
+
+    // Carga acumulada em mA*us
+    float charge = (float)report->cpu_active_us * POWER_MA_CPU_ACTIVE;
+    charge += (float)sleep_us * (LOW_POWER_MODE ? POWER_MA_CPU_SLEEP : POWER_MA_CPU_IDLE);
+    charge += (float)now_us * POWER_MA_SENSOR;
+#if !LOW_POWER_MODE
+    charge += (float)now_us * POWER_MA_USB;
+#elif LOW_POWER_UART_STDIO
+    charge += (float)report->cpu_active_us * POWER_MA_UART;
+#endif
+    charge += (float)display_get_power_time_us(DISPLAY_POWER_ON) * POWER_MA_DISPLAY_ON;
+    charge += (float)display_get_power_time_us(DISPLAY_POWER_DIM) * POWER_MA_DISPLAY_DIM;
+    charge += (float)display_get_power_time_us(DISPLAY_POWER_OFF) * POWER_MA_DISPLAY_OFF;
+
+    report->avg_ma = now_us > 0 ? charge / (float)now_us : 0.0f;
+    report->consumed_mah = charge / 3.6e9f;  // mA*us -> mAh
+    report->battery_hours = report->avg_ma > 0.0f ? POWER_BATTERY_MAH / report->avg_ma : 0.0f;
+}
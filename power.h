@@ -0,0 +1,50 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Modo de baixo consumo (definido pelo CMake: -DLOW_POWER_MODE=ON)
+#ifndef LOW_POWER_MODE
+#define LOW_POWER_MODE 0
+#endif
+
+// Saída serial por UART no modo de baixo consumo (-DLOW_POWER_UART_STDIO=ON).
+// Substitui o USB (desligado nesse modo) por uma UART de custo bem menor, só para relatórios.
+#ifndef LOW_POWER_UART_STDIO
+#define LOW_POWER_UART_STDIO 0
+#endif
+
+// ===== MODELO DE ENERGIA =====
+// Correntes estimadas por estado (mA @ 3.3V). Valores típicos de datasheet/bancada,
+// usados apenas para comparar o efeito de mudanças na autonomia estimada.
+#define POWER_MA_CPU_ACTIVE     25.0f   // RP2040 @ 125 MHz executando
+#define POWER_MA_CPU_IDLE       15.0f   // WFE com todos os clocks ligados (modo normal)
+#define POWER_MA_CPU_SLEEP      4.0f    // Sono profundo com clocks de periféricos bloqueados
+#define POWER_MA_USB            5.0f    // Controlador USB ativo (somente modo normal)
+#define POWER_MA_UART           0.5f    // UART acordada com a CPU (LOW_POWER_UART_STDIO)
+#define POWER_MA_DISPLAY_ON     12.0f   // SSD1306, contraste 0xCF
+#define POWER_MA_DISPLAY_DIM    4.0f    // SSD1306, contraste reduzido
+#define POWER_MA_DISPLAY_OFF    0.01f   // SSD1306 em DISPLAYOFF (GDDRAM preservada)
+#define POWER_MA_SENSOR         0.25f   // AHT10 (média, medição a cada 2 s)
+
+// Bateria usada na estimativa de autonomia
+#define POWER_BATTERY_MAH       2000.0f
+
+// Resumo do modelo de energia
+typedef struct {
+    uint64_t uptime_us;          // Tempo total contabilizado
+    uint64_t cpu_active_us;      // CPU executando
+    uint64_t cpu_sleep_us;       // CPU aguardando (WFE ou sono profundo)
+    float avg_ma;                // Corrente média estimada
+    float consumed_mah;          // Carga consumida desde o boot
+    float battery_hours;         // Autonomia estimada com bateria cheia
+} power_report_t;
+
+// Funções de energia
+void power_init(void);
+bool power_sleep_until(absolute_time_t deadline);
+void power_get_report(power_report_t* report);
+
+#endif // POWER_H